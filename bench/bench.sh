@@ -0,0 +1,134 @@
+#!/bin/sh
+#
+# Run gcsa_locate over a matrix of parameters and collect the statistics of each
+# run into one table.
+#
+# Usage: bench.sh -x GCSA_LOCATE -g GCSA -o OUTDIR [-k "K..."] [-d "DIST..."]
+#                 [-s "STRATEGY..."] [-t "THREADS..."] [-n REPEAT]
+#                 [-y GCSA_SIMULATE -f FASTA -w "N:L:E:I..."] [READS...]
+#
+# Workloads given by `-w` are simulated from FASTA (unless already present in
+# OUTDIR/workloads) and benchmarked in addition to READS files. For each reads file,
+# seed length, seeding strategy and thread count (and for each distance if the
+# strategy is `step`) the tool is run REPEAT times. Statistics of each run are
+# stored in OUTDIR/runs and summarised in OUTDIR/bench.tsv. The phase timings of
+# the repetitions are also written to OUTDIR/bench.json for `bench_compare`.
+
+usage() {
+  sed -n 's/^# \{0,1\}//; 3,17p' "$0" >&2
+  exit 1
+}
+
+. "$(dirname "$0")/common.sh"
+
+exe=
+gcsa=
+outdir=bench-results
+kvalues="16"
+distances="0"
+strategies="step"
+threads="1"
+repeat=1
+simulator=
+fasta=
+workloads=
+
+while getopts "x:g:o:k:d:s:t:n:y:f:w:h" opt; do
+  case $opt in
+    x) exe=$OPTARG ;;
+    g) gcsa=$OPTARG ;;
+    o) outdir=$OPTARG ;;
+    k) kvalues=$OPTARG ;;
+    d) distances=$OPTARG ;;
+    s) strategies=$OPTARG ;;
+    t) threads=$OPTARG ;;
+    n) repeat=$OPTARG ;;
+    y) simulator=$OPTARG ;;
+    f) fasta=$OPTARG ;;
+    w) workloads=$OPTARG ;;
+    *) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+[ -n "$exe" ] && [ -n "$gcsa" ] || usage
+[ -x "$exe" ] || { echo "bench.sh: '$exe' is not executable" >&2; exit 1; }
+[ -z "$workloads" ] || { [ -n "$simulator" ] && [ -n "$fasta" ]; } || usage
+
+mkdir -p "$outdir/runs" || exit 1
+
+# Simulate workloads and add them to the list of reads files.
+for w in $workloads; do
+  file=$(simulate_workload "$simulator" "$fasta" "$outdir/workloads" "$w") || exit 1
+  set -- "$@" "$file"
+done
+[ $# -gt 0 ] || usage
+
+phases="index sequences patterns find locate output"
+counters="sequences patterns found paths occurrences output_bytes max_rss_kb"
+
+table="$outdir/bench.tsv"
+{
+  printf "reads\tk\tdistance\tstrategy\tthreads\trep"
+  for p in $phases; do printf "\t%s_us" "$p"; done
+  for c in $counters; do printf "\t%s" "$c"; done
+  printf "\n"
+} > "$table"
+
+for reads in "$@"; do
+  rname=$(basename "$reads" .seq)
+  for k in $kvalues; do
+    for s in $strategies; do
+      if [ "$s" = "step" ]; then dlist=$distances; else dlist=0; fi
+      for d in $dlist; do
+        for t in $threads; do
+          rep=1
+          while [ "$rep" -le "$repeat" ]; do
+            id="$rname.k$k.d$d.$s.t$t.r$rep"
+            stats="$outdir/runs/$id.json"
+            echo "bench.sh: $id" >&2
+            if ! "$exe" -g "$gcsa" -l "$k" -d "$d" -s "$s" -t "$t" \
+                 -o /dev/null -S "$stats" "$reads" > "$outdir/runs/$id.log" 2>&1; then
+              echo "bench.sh: run $id failed; see $outdir/runs/$id.log" >&2
+              exit 1
+            fi
+            {
+              printf "%s\t%s\t%s\t%s\t%s\t%s" "$rname" "$k" "$d" "$s" "$t" "$rep"
+              for p in $phases; do printf "\t%s" "$(stat_value "$stats" phases "$p")"; done
+              for c in $counters; do printf "\t%s" "$(stat_value "$stats" counters "$c")"; done
+              printf "\n"
+            } >> "$table"
+            rep=$((rep + 1))
+          done
+        done
+      done
+    done
+  done
+done
+
+# Group the repetitions of each configuration by phase.
+awk -F '\t' -v nphases="$(set -- $phases; echo $#)" '
+  NR == 1 { for (i = 7; i < 7 + nphases; ++i) { phase[i] = $i; sub(/_us$/, "", phase[i]) }; next }
+  {
+    config = $1 "/k:" $2 "/d:" $3 "/" $4 "/t:" $5
+    if (!(config in seen)) { seen[config] = 1; order[++n] = config }
+    for (i = 7; i < 7 + nphases; ++i) {
+      key = config SUBSEP i
+      if (key in values) values[key] = values[key] ", " $i
+      else values[key] = $i
+    }
+  }
+  END {
+    printf "{\n  \"context\": {\n    \"program\": \"bench.sh\"\n  },\n  \"benchmarks\": ["
+    sep = ""
+    for (c = 1; c <= n; ++c) {
+      for (i = 7; i < 7 + nphases; ++i) {
+        printf "%s\n    {\n      \"name\": \"%s/%s\",\n      \"unit\": \"us\",\n", sep, order[c], phase[i]
+        printf "      \"values\": [%s]\n    }", values[order[c] SUBSEP i]
+        sep = ","
+      }
+    }
+    printf "\n  ]\n}\n"
+  }' "$table" > "$outdir/bench.json"
+
+column -t -s "$(printf '\t')" "$table" 2>/dev/null || cat "$table"
@@ -0,0 +1,203 @@
+/**
+ *    @file  coalesce_bench.cc
+ *   @brief  Request coalescing benchmark.
+ *
+ *  Measures throughput and latency of concurrent small requests answered directly or
+ *  through the request coalescer with different windows.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  10:40
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "locator.h"
+#include "coalescer.h"
+#include "seed.h"
+
+
+typedef std::chrono::steady_clock clock_type;
+
+struct Result {
+  double seeds_per_s;
+  double p50_us;
+  double p99_us;
+  double batch_requests;    /**< @brief Mean number of requests per batch. */
+};
+
+/**
+ *  @brief  Run `clients` closed-loop clients for `seconds`.
+ *
+ *  Each client repeatedly submits the seeds of the next read as one request and
+ *  waits for its result. If `coalescer` is null, the clients query the locator
+ *  directly.
+ */
+  inline Result
+run( const Locator& locator, Coalescer* coalescer,
+    const std::vector< std::vector< std::string > >& requests, unsigned int clients,
+    double seconds )
+{
+  std::atomic< std::size_t > next( 0 );
+  std::atomic< std::uint64_t > nof_seeds( 0 );
+  std::vector< std::vector< double > > latencies( clients );
+  std::size_t batches = coalescer ? coalescer->get_batches() : 0;
+  std::size_t nof_requests = coalescer ? coalescer->get_requests() : 0;
+  auto start = clock_type::now();
+  auto deadline = start + std::chrono::duration_cast< clock_type::duration >(
+      std::chrono::duration< double >( seconds ) );
+  std::vector< std::thread > threads;
+  for ( unsigned int c = 0; c < clients; ++c ) {
+    threads.emplace_back( [&, c]( ) {
+        Hits hits;
+        while ( clock_type::now() < deadline ) {
+          const auto& seeds = requests[ next++ % requests.size() ];
+          auto rstart = clock_type::now();
+          if ( coalescer ) hits = coalescer->submit( seeds ).get();
+          else locator.locate( seeds.begin(), seeds.end(), hits );
+          latencies[ c ].push_back( std::chrono::duration< double, std::micro >(
+                clock_type::now() - rstart ).count() );
+          nof_seeds += seeds.size();
+        }
+        } );
+  }
+  for ( auto& t : threads ) t.join();
+  double secs = std::chrono::duration< double >( clock_type::now() - start ).count();
+
+  std::vector< double > all;
+  for ( const auto& l : latencies ) all.insert( all.end(), l.begin(), l.end() );
+  std::sort( all.begin(), all.end() );
+  Result res{ nof_seeds / secs, 0, 0, 1 };
+  if ( !all.empty() ) {
+    res.p50_us = all[ all.size() / 2 ];
+    res.p99_us = all[ std::min( all.size() - 1, all.size() * 99 / 100 ) ];
+  }
+  if ( coalescer && coalescer->get_batches() != batches ) {
+    res.batch_requests = static_cast< double >( coalescer->get_requests() - nof_requests )
+      / ( coalescer->get_batches() - batches );
+  }
+  return res;
+}
+
+  inline std::vector< std::string >
+split( const std::string& str )
+{
+  std::vector< std::string > tokens;
+  std::size_t pos = 0;
+  while ( pos <= str.size() ) {
+    std::size_t end = std::min( str.find( ',', pos ), str.size() );
+    if ( end > pos ) tokens.push_back( str.substr( pos, end - pos ) );
+    pos = end + 1;
+  }
+  return tokens;
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  std::string gcsa_name = "test/data/complex/c.gcsa";
+  std::string reads_name = "test/data/complex/reads_n100l100e0i0.seq";
+  std::string windows = "0,50,200,1000";
+  std::string csv_filename;
+  unsigned int k = 16;
+  unsigned int clients = 16;
+  std::size_t batch_size = 4096;
+  double seconds = 2;
+  for ( int i = 1; i < argc; ++i ) {
+    std::string arg = argv[ i ];
+    auto next = [&]( ) -> std::string {
+      if ( i + 1 == argc ) throw std::runtime_error( "missing value for " + arg );
+      return argv[ ++i ];
+    };
+    if ( arg == "--gcsa" ) gcsa_name = next();
+    else if ( arg == "--reads" ) reads_name = next();
+    else if ( arg == "--k" ) k = std::stoul( next() );
+    else if ( arg == "--clients" ) clients = std::stoul( next() );
+    else if ( arg == "--windows" ) windows = next();
+    else if ( arg == "--batch-size" ) batch_size = std::stoull( next() );
+    else if ( arg == "--seconds" ) seconds = std::stod( next() );
+    else if ( arg == "--csv" ) csv_filename = next();
+    else {
+      std::cerr << "Usage: " << argv[ 0 ] << " [--gcsa GCSA] [--reads READS] [--k K]"
+                << " [--clients C] [--windows US1,US2,...] [--batch-size N]"
+                << " [--seconds S] [--csv FILE]" << std::endl << std::endl
+                << "C closed-loop clients each submit the k-mers of one read per request"
+                << std::endl
+                << "for S seconds, directly and through the coalescer with each window"
+                << std::endl
+                << "(in microseconds) and batch size N." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if ( clients == 0 ) clients = 1;
+
+  Locator locator( gcsa_name );
+  std::vector< std::vector< std::string > > requests;
+  {
+    std::ifstream ifs( reads_name, std::ifstream::in );
+    if ( !ifs ) throw std::runtime_error( "could not open file '" + reads_name + "'" );
+    std::string line;
+    while ( std::getline( ifs, line ) ) {
+      if ( line.size() < k ) continue;
+      requests.emplace_back();
+      seeding( requests.back(), std::vector< std::string >( 1, line ), k,
+          GreedyOverlapping() );
+    }
+  }
+  if ( requests.empty() ) {
+    throw std::runtime_error( "no reads of length at least " + std::to_string( k )
+        + " in '" + reads_name + "'" );
+  }
+
+  std::ofstream csv;
+  if ( !csv_filename.empty() ) {
+    csv.open( csv_filename, std::ofstream::out );
+    if ( !csv ) {
+      throw std::runtime_error( "could not open file '" + csv_filename + "'" );
+    }
+    csv << "mode,window_us,clients,seeds_per_s,p50_us,p99_us,requests_per_batch"
+        << std::endl;
+  }
+  std::cout << std::left << std::setw( 12 ) << "mode" << std::right << std::setw( 10 )
+            << "window us" << std::setw( 14 ) << "seeds/s" << std::setw( 12 )
+            << "p50 us" << std::setw( 12 ) << "p99 us" << std::setw( 14 )
+            << "reqs/batch" << std::endl;
+  auto report = [&]( const std::string& mode, const std::string& window,
+      const Result& res ) {
+    std::cout << std::left << std::setw( 12 ) << mode << std::right << std::setw( 10 )
+              << window << std::fixed << std::setprecision( 0 ) << std::setw( 14 )
+              << res.seeds_per_s << std::setprecision( 1 ) << std::setw( 12 )
+              << res.p50_us << std::setw( 12 ) << res.p99_us << std::setw( 14 )
+              << res.batch_requests << std::endl;
+    if ( csv.is_open() ) {
+      csv << mode << "," << window << "," << clients << "," << res.seeds_per_s << ","
+          << res.p50_us << "," << res.p99_us << "," << res.batch_requests << std::endl;
+    }
+  };
+
+  report( "direct", "-", run( locator, nullptr, requests, clients, seconds ) );
+  for ( const auto& window : split( windows ) ) {
+    Coalescer coalescer( locator, batch_size,
+        Coalescer::duration_type( std::stoul( window ) ) );
+    report( "coalesced", window, run( locator, &coalescer, requests, clients, seconds ) );
+  }
+  return EXIT_SUCCESS;
+}
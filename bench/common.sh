@@ -0,0 +1,38 @@
+# Helper functions shared by the benchmark drivers; to be sourced.
+
+# Print the value of `key` in the `section` object of a stats JSON file written by
+# `gcsa_locate --stats`.
+#
+# Usage: stat_value FILE SECTION KEY
+stat_value() {
+  awk -v section="$2" -v key="$3" '
+    /^  "[a-z_]*": \{/ { split($0, f, "\""); current = f[2]; next }
+    current == section && index($0, "\"" key "\":") {
+      sub(/^[^:]*: */, ""); sub(/,$/, ""); gsub(/"/, ""); print; exit
+    }' "$1"
+}
+
+# Print the median of the arguments.
+median() {
+  printf "%s\n" "$@" | sort -n | awk '
+    { v[NR] = $1 }
+    END { if (NR % 2) print v[(NR + 1) / 2]; else print (v[NR / 2] + v[NR / 2 + 1]) / 2 }'
+}
+
+# Simulate a workload `count:length:subst-rate:indel-rate` into DIR unless it
+# exists, and print the name of the reads file.
+#
+# Usage: simulate_workload GCSA_SIMULATE FASTA DIR SPEC
+simulate_workload() {
+  (
+    IFS=:
+    set -- "$1" "$2" "$3" $4
+    file="$3/$(printf 'reads_n%sl%se%si%s.seq' "$4" "$5" "$6" "$7")"
+    if [ ! -f "$file" ]; then
+      mkdir -p "$3"
+      "$1" -f "$2" -n "$4" -l "$5" -e "$6" -i "$7" -o "$file" >&2 ||
+        { rm -f "$file"; exit 1; }
+    fi
+    echo "$file"
+  )
+}
@@ -0,0 +1,408 @@
+/**
+ *    @file  compare.cc
+ *   @brief  Benchmark comparison program.
+ *
+ *  Compares benchmark results of a candidate against a baseline and reports
+ *  performance regressions.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  17:10
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <cmath>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <map>
+#include <regex>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+
+/**
+ *  @brief  Minimal JSON value.
+ *
+ *  Only what is needed to read the benchmark results: objects keep the order of
+ *  their members; numbers are doubles.
+ */
+struct JsonValue {
+  enum Type { Null, Bool, Number, String, Array, Object };
+  Type type = Null;
+  double number = 0;
+  std::string string;
+  std::vector< JsonValue > array;
+  std::vector< std::pair< std::string, JsonValue > > object;
+
+    inline const JsonValue*
+  get( const std::string& key ) const
+  {
+    for ( const auto& member : this->object ) {
+      if ( member.first == key ) return &member.second;
+    }
+    return nullptr;
+  }
+};
+
+/**
+ *  @brief  Recursive-descent JSON parser.
+ */
+class JsonParser
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    JsonParser( const std::string& t ) : text( t ), pos( 0 ) { }
+    /* ====================  METHODS       ======================================= */
+      inline JsonValue
+    parse( )
+    {
+      JsonValue value = this->parse_value();
+      this->skip_ws();
+      if ( this->pos != this->text.size() ) this->error( "trailing characters" );
+      return value;
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    const std::string& text;
+    std::size_t pos;
+    /* ====================  METHODS       ======================================= */
+      inline void
+    error( const std::string& msg ) const
+    {
+      throw std::runtime_error( "JSON parse error at offset " + std::to_string( this->pos )
+          + ": " + msg );
+    }
+
+      inline void
+    skip_ws( )
+    {
+      while ( this->pos < this->text.size() && std::isspace( this->text[ this->pos ] ) ) {
+        ++this->pos;
+      }
+    }
+
+      inline char
+    peek( )
+    {
+      this->skip_ws();
+      if ( this->pos == this->text.size() ) this->error( "unexpected end" );
+      return this->text[ this->pos ];
+    }
+
+      inline void
+    expect( char c )
+    {
+      if ( this->peek() != c ) this->error( std::string( "expected '" ) + c + "'" );
+      ++this->pos;
+    }
+
+      inline bool
+    consume( const std::string& word )
+    {
+      if ( this->text.compare( this->pos, word.size(), word ) != 0 ) return false;
+      this->pos += word.size();
+      return true;
+    }
+
+      inline std::string
+    parse_string( )
+    {
+      this->expect( '"' );
+      std::string str;
+      while ( this->pos < this->text.size() && this->text[ this->pos ] != '"' ) {
+        char c = this->text[ this->pos++ ];
+        if ( c == '\\' && this->pos < this->text.size() ) {
+          c = this->text[ this->pos++ ];
+          if ( c == 'n' ) c = '\n';
+          else if ( c == 't' ) c = '\t';
+        }
+        str += c;
+      }
+      this->expect( '"' );
+      return str;
+    }
+
+      inline JsonValue
+    parse_value( )
+    {
+      JsonValue value;
+      char c = this->peek();
+      if ( c == '{' ) {
+        value.type = JsonValue::Object;
+        ++this->pos;
+        if ( this->peek() == '}' ) {
+          ++this->pos;
+          return value;
+        }
+        do {
+          std::string key = this->parse_string();
+          this->expect( ':' );
+          value.object.emplace_back( key, this->parse_value() );
+        } while ( this->peek() == ',' && ++this->pos );
+        this->expect( '}' );
+      }
+      else if ( c == '[' ) {
+        value.type = JsonValue::Array;
+        ++this->pos;
+        if ( this->peek() == ']' ) {
+          ++this->pos;
+          return value;
+        }
+        do {
+          value.array.push_back( this->parse_value() );
+        } while ( this->peek() == ',' && ++this->pos );
+        this->expect( ']' );
+      }
+      else if ( c == '"' ) {
+        value.type = JsonValue::String;
+        value.string = this->parse_string();
+      }
+      else if ( this->consume( "true" ) ) {
+        value.type = JsonValue::Bool;
+        value.number = 1;
+      }
+      else if ( this->consume( "false" ) ) {
+        value.type = JsonValue::Bool;
+      }
+      else if ( this->consume( "null" ) ) {
+        value.type = JsonValue::Null;
+      }
+      else {
+        const char* begin = this->text.c_str() + this->pos;
+        char* end;
+        value.type = JsonValue::Number;
+        value.number = std::strtod( begin, &end );
+        if ( end == begin ) this->error( "invalid value" );
+        this->pos += end - begin;
+      }
+      return value;
+    }
+};  /* -----  end of class JsonParser  ----- */
+
+/**
+ *  @brief  Measurements of a benchmark in one results file.
+ */
+struct Measurement {
+  std::string unit;
+  std::vector< double > values;
+};
+
+typedef std::vector< std::pair< std::string, Measurement > > results_type;
+
+/**
+ *  @brief  Load benchmark results.
+ *
+ *  Accepts the results written by the micro-benchmarks and `bench.sh` (having a
+ *  "benchmarks" array) as well as a single `gcsa_locate --stats` file whose
+ *  phases are taken as benchmarks named "phases/<name>".
+ */
+  inline results_type
+load_results( const std::string& filename )
+{
+  std::ifstream ifs( filename, std::ifstream::in );
+  if ( !ifs ) {
+    throw std::runtime_error( "could not open file '" + filename + "'" );
+  }
+  std::stringstream buffer;
+  buffer << ifs.rdbuf();
+  std::string text = buffer.str();
+  JsonValue root = JsonParser( text ).parse();
+
+  results_type results;
+  if ( const JsonValue* benchmarks = root.get( "benchmarks" ) ) {
+    for ( const auto& bm : benchmarks->array ) {
+      const JsonValue* name = bm.get( "name" );
+      const JsonValue* values = bm.get( "values" );
+      if ( name == nullptr || values == nullptr ) continue;
+      Measurement m;
+      if ( const JsonValue* unit = bm.get( "unit" ) ) m.unit = unit->string;
+      for ( const auto& v : values->array ) m.values.push_back( v.number );
+      results.emplace_back( name->string, m );
+    }
+  }
+  else if ( const JsonValue* phases = root.get( "phases" ) ) {
+    for ( const auto& phase : phases->object ) {
+      results.emplace_back( "phases/" + phase.first,
+          Measurement{ "us", { phase.second.number } } );
+    }
+  }
+  else {
+    throw std::runtime_error( "no benchmark results found in '" + filename + "'" );
+  }
+  return results;
+}
+
+  inline double
+median( std::vector< double > values )
+{
+  if ( values.empty() ) return 0;
+  std::sort( values.begin(), values.end() );
+  std::size_t mid = values.size() / 2;
+  if ( values.size() % 2 ) return values[ mid ];
+  return ( values[ mid - 1 ] + values[ mid ] ) / 2;
+}
+
+/**
+ *  @brief  Relative noise of the measurements.
+ *
+ *  The median absolute deviation relative to the median; zero for less than three
+ *  repetitions.
+ */
+  inline double
+relative_noise( const std::vector< double >& values )
+{
+  if ( values.size() < 3 ) return 0;
+  double med = median( values );
+  if ( med == 0 ) return 0;
+  std::vector< double > deviations;
+  for ( double v : values ) deviations.push_back( std::fabs( v - med ) );
+  return median( deviations ) / med;
+}
+
+
+/**
+ *  @brief  Compare the results files given on the command line.
+ *
+ *  @return the exit status of the program.
+ */
+  inline int
+run( int argc, char* argv[] )
+{
+  double threshold = 0.05;
+  double noise_factor = 3;
+  double min_value = 0;
+  std::string filter = ".*";
+  bool allow_missing = false;
+  std::vector< std::string > files;
+  for ( int i = 1; i < argc; ++i ) {
+    std::string arg = argv[ i ];
+    auto next = [&]( ) -> std::string {
+      if ( i + 1 == argc ) throw std::runtime_error( "missing value for " + arg );
+      return argv[ ++i ];
+    };
+    if ( arg == "--threshold" ) threshold = std::stod( next() );
+    else if ( arg == "--noise-factor" ) noise_factor = std::stod( next() );
+    else if ( arg == "--min-value" ) min_value = std::stod( next() );
+    else if ( arg == "--filter" ) filter = next();
+    else if ( arg == "--allow-missing" ) allow_missing = true;
+    else if ( !arg.empty() && arg[ 0 ] != '-' ) files.push_back( arg );
+    else {
+      files.clear();
+      break;
+    }
+  }
+  if ( files.size() != 2 ) {
+    std::cerr << "Usage: " << argv[ 0 ] << " [--threshold FRACTION] [--noise-factor F]"
+              << " [--min-value V] [--filter REGEX] [--allow-missing] BASELINE CANDIDATE"
+              << std::endl
+              << std::endl
+              << "Compare the median of the repetitions of each benchmark in CANDIDATE"
+              << std::endl
+              << "to BASELINE. A benchmark regresses if its median increases by more"
+              << std::endl
+              << "than the threshold [default: 0.05] and by more than noise-factor"
+              << std::endl
+              << "[default: 3] times the relative median absolute deviation of either"
+              << std::endl
+              << "side. Benchmarks whose baseline median is below min-value are not"
+              << std::endl
+              << "checked. Exit status is 1 if there is any regression or if a"
+              << std::endl
+              << "benchmark of BASELINE is missing from CANDIDATE, unless missing ones"
+              << std::endl
+              << "are allowed, and 2 on errors." << std::endl;
+    return 2;
+  }
+
+  results_type baseline = load_results( files[ 0 ] );
+  results_type candidate = load_results( files[ 1 ] );
+  std::map< std::string, const Measurement* > base_map;
+  for ( const auto& res : baseline ) base_map[ res.first ] = &res.second;
+
+  std::regex re( filter );
+  std::size_t regressions = 0;
+  std::size_t improvements = 0;
+  std::size_t compared = 0;
+  std::size_t missing = 0;
+  std::cout << std::left << std::setw( 56 ) << "benchmark" << std::right
+            << std::setw( 14 ) << "baseline" << std::setw( 14 ) << "candidate"
+            << std::setw( 10 ) << "delta" << std::setw( 9 ) << "noise" << std::setw( 6 )
+            << "unit" << "  status"
+            << std::endl;
+  for ( const auto& res : candidate ) {
+    if ( !std::regex_search( res.first, re ) ) continue;
+    auto found = base_map.find( res.first );
+    std::cout << std::left << std::setw( 56 ) << res.first << std::right;
+    if ( found == base_map.end() ) {
+      std::cout << std::setw( 14 ) << "-" << std::setw( 14 ) << std::fixed
+                << std::setprecision( 1 ) << median( res.second.values ) << "  new"
+                << std::endl;
+      continue;
+    }
+    const Measurement& base = *found->second;
+    base_map.erase( found );
+    double b = median( base.values );
+    double c = median( res.second.values );
+    double delta = b == 0 ? 0 : ( c - b ) / b;
+    double noise = noise_factor * std::max( relative_noise( base.values ),
+        relative_noise( res.second.values ) );
+    double limit = std::max( threshold, noise );
+    std::string status = "ok";
+    if ( b < min_value ) {
+      status = "skipped";
+    }
+    else {
+      ++compared;
+      if ( delta > limit ) {
+        status = "REGRESSION";
+        ++regressions;
+      }
+      else if ( delta < -limit ) {
+        status = "improved";
+        ++improvements;
+      }
+    }
+    std::cout << std::fixed << std::setprecision( 1 ) << std::setw( 14 ) << b
+              << std::setw( 14 ) << c << std::setw( 9 ) << std::showpos << delta * 100
+              << "%" << std::noshowpos << std::setw( 8 ) << noise * 100 << "%"
+              << std::setw( 6 ) << base.unit << "  " << status << std::endl;
+  }
+  /* A benchmark renamed or crashed in the candidate must not pass unnoticed. */
+  for ( const auto& res : base_map ) {
+    if ( !std::regex_search( res.first, re ) ) continue;
+    ++missing;
+    std::cout << std::left << std::setw( 56 ) << res.first << std::right
+              << std::setw( 14 ) << std::fixed << std::setprecision( 1 )
+              << median( res.second->values ) << std::setw( 14 ) << "-"
+              << ( allow_missing ? "  missing" : "  MISSING" ) << std::endl;
+  }
+
+  std::cout << std::endl << compared << " compared, " << regressions << " regressed, "
+            << improvements << " improved, " << missing << " missing." << std::endl;
+  if ( regressions != 0 || ( missing != 0 && !allow_missing ) ) return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  try {
+    return run( argc, argv );
+  }
+  catch ( const std::exception& e ) {
+    std::cerr << argv[ 0 ] << ": " << e.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,497 @@
+/**
+ *    @file  harness.h
+ *   @brief  Micro-benchmark harness.
+ *
+ *  A minimal micro-benchmark framework in the spirit of Google Benchmark.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  14:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef HARNESS_H__
+#define HARNESS_H__
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <regex>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <stdexcept>
+
+/* Each benchmark program consists of a single translation unit, so the global
+ * allocation functions counting the allocations are defined here. They are not
+ * inlined; otherwise GCC reports `free` on memory coming from `operator new`. */
+namespace bench {
+  /** @brief Number of allocations made by the program so far. */
+  inline std::atomic< std::uint64_t >& allocation_count( )
+  {
+    static std::atomic< std::uint64_t > count( 0 );
+    return count;
+  }
+}  /* -----  end of namespace bench  ----- */
+
+__attribute__(( noinline )) void* operator new( std::size_t size )
+{
+  bench::allocation_count().fetch_add( 1, std::memory_order_relaxed );
+  if ( void* ptr = std::malloc( size ? size : 1 ) ) return ptr;
+  throw std::bad_alloc();
+}
+
+__attribute__(( noinline )) void* operator new[]( std::size_t size )
+{
+  return ::operator new( size );
+}
+
+__attribute__(( noinline )) void operator delete( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete[]( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete( void* ptr, std::size_t ) noexcept
+{
+  std::free( ptr );
+}
+
+__attribute__(( noinline )) void operator delete[]( void* ptr, std::size_t ) noexcept
+{
+  std::free( ptr );
+}
+
+namespace bench {
+  /**
+   *  @brief  Prevent the compiler from optimising away `value`.
+   */
+  template< typename TValue >
+      inline void
+    do_not_optimize( TValue const& value )
+    {
+      asm volatile( "" : : "r,m"( value ) : "memory" );
+    }
+
+  /**
+   *  @brief  Hardware cache-miss counter of the calling thread.
+   *
+   *  Uses `perf_event_open(2)`; if it is not permitted (e.g. by
+   *  `perf_event_paranoid` or in containers) the counter is unavailable and reads 0.
+   */
+  class CacheMissCounter
+  {
+    public:
+      /* ====================  LIFECYCLE     ======================================= */
+      CacheMissCounter( )
+      {
+        struct perf_event_attr attr;
+        std::memset( &attr, 0, sizeof( attr ) );
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof( attr );
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        this->fd = syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+        if ( this->fd != -1 ) ioctl( this->fd, PERF_EVENT_IOC_ENABLE, 0 );
+      }  /* -----  end of method CacheMissCounter  (constructor)  ----- */
+
+      ~CacheMissCounter( )
+      {
+        if ( this->fd != -1 ) close( this->fd );
+      }  /* -----  end of method ~CacheMissCounter  (destructor)  ----- */
+      /* ====================  METHODS       ======================================= */
+        static inline CacheMissCounter&
+      instance( )
+      {
+        static CacheMissCounter counter;
+        return counter;
+      }
+
+        inline bool
+      available( ) const
+      {
+        return this->fd != -1;
+      }
+
+        inline std::uint64_t
+      read( ) const
+      {
+        std::uint64_t value = 0;
+        if ( this->fd == -1 || ::read( this->fd, &value, sizeof( value ) ) != sizeof( value ) ) {
+          return 0;
+        }
+        return value;
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      int fd;
+  };  /* -----  end of class CacheMissCounter  ----- */
+
+  /**
+   *  @brief  Benchmark state.
+   *
+   *  The benchmark function runs its measured code in a loop:
+   *
+   *      while ( state.keep_running() ) { ... }
+   *
+   *  Time, allocations and cache misses are only measured inside the loop and outside of
+   *  `pause_timing()`/`resume_timing()` pairs.
+   */
+  class State
+  {
+    public:
+      /* ====================  MEMBER TYPES  ======================================= */
+      typedef std::chrono::steady_clock clock_type;
+      /* ====================  LIFECYCLE     ======================================= */
+      State( std::uint64_t max_iters )
+        : iterations( 0 ), max_iterations( max_iters ), items( 0 ),
+        elapsed( clock_type::duration::zero() ), allocations( 0 ), cache_misses( 0 ),
+        running( false )
+      { }
+      /* ====================  ACCESSORS     ======================================= */
+        inline std::uint64_t
+      get_iterations( ) const
+      {
+        return this->iterations;
+      }
+
+        inline double
+      get_seconds( ) const
+      {
+        return std::chrono::duration< double >( this->elapsed ).count();
+      }
+
+        inline std::uint64_t
+      get_allocations( ) const
+      {
+        return this->allocations;
+      }
+
+        inline std::uint64_t
+      get_cache_misses( ) const
+      {
+        return this->cache_misses;
+      }
+
+        inline std::uint64_t
+      get_items( ) const
+      {
+        return this->items;
+      }
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      keep_running( )
+      {
+        if ( this->iterations == 0 && !this->running ) {
+          this->resume_timing();
+        }
+        if ( this->iterations == this->max_iterations ) {
+          this->pause_timing();
+          return false;
+        }
+        ++this->iterations;
+        return true;
+      }
+
+        inline void
+      pause_timing( )
+      {
+        if ( !this->running ) return;
+        this->elapsed += clock_type::now() - this->start;
+        this->allocations += allocation_count().load( std::memory_order_relaxed )
+          - this->start_allocations;
+        this->cache_misses += CacheMissCounter::instance().read() - this->start_misses;
+        this->running = false;
+      }
+
+        inline void
+      resume_timing( )
+      {
+        if ( this->running ) return;
+        this->running = true;
+        this->start_allocations = allocation_count().load( std::memory_order_relaxed );
+        this->start_misses = CacheMissCounter::instance().read();
+        this->start = clock_type::now();
+      }
+
+      /**
+       *  @brief  Set the total number of items processed in all iterations.
+       *
+       *  Enables the `items_per_s`, `ns_per_item`, `allocs_per_item` and
+       *  `misses_per_item` counters.
+       */
+        inline void
+      set_items_processed( std::uint64_t n )
+      {
+        this->items = n;
+      }
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::map< std::string, double > counters;  /**< @brief User-defined counters. */
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::uint64_t iterations;
+      std::uint64_t max_iterations;
+      std::uint64_t items;
+      clock_type::duration elapsed;
+      clock_type::time_point start;
+      std::uint64_t allocations;
+      std::uint64_t start_allocations;
+      std::uint64_t cache_misses;
+      std::uint64_t start_misses;
+      bool running;
+  };  /* -----  end of class State  ----- */
+
+  struct Benchmark {
+    std::string name;
+    std::function< void( State& ) > function;
+  };
+
+  /**
+   *  @brief  Result of all repetitions of a benchmark.
+   */
+  struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    std::vector< double > values;                 /**< @brief ns per iteration. */
+    std::map< std::string, double > counters;     /**< @brief Mean over repetitions. */
+  };
+
+    inline std::vector< Benchmark >&
+  registry( )
+  {
+    static std::vector< Benchmark > benchmarks;
+    return benchmarks;
+  }
+
+  /**
+   *  @brief  Register a benchmark.
+   *
+   *  @param  name The unique name of the benchmark.
+   *  @param  function The benchmark function.
+   */
+    inline void
+  register_benchmark( const std::string& name, std::function< void( State& ) > function )
+  {
+    registry().push_back( { name, std::move( function ) } );
+  }
+
+    inline double
+  median( std::vector< double > values )
+  {
+    if ( values.empty() ) return 0;
+    std::sort( values.begin(), values.end() );
+    std::size_t mid = values.size() / 2;
+    if ( values.size() % 2 ) return values[ mid ];
+    return ( values[ mid - 1 ] + values[ mid ] ) / 2;
+  }
+
+  /**
+   *  @brief  Run one benchmark.
+   *
+   *  The number of iterations is first calibrated such that one repetition takes at
+   *  least `min_time` seconds; then the benchmark is run `warmup` times without
+   *  recording the results before being repeated `repetitions` times.
+   */
+    inline Result
+  run( const Benchmark& bm, double min_time, unsigned int repetitions,
+      unsigned int warmup )
+  {
+    std::uint64_t iters = 1;
+    while ( true ) {
+      State state( iters );
+      bm.function( state );
+      double secs = state.get_seconds();
+      if ( secs >= min_time || iters >= ( 1ULL << 40 ) ) break;
+      double factor = secs <= 0 ? 100 : std::min( 100.0, min_time * 1.4 / secs );
+      iters = std::max< std::uint64_t >( iters + 1, iters * factor );
+    }
+
+    for ( unsigned int r = 0; r < warmup; ++r ) {
+      State state( iters );
+      bm.function( state );
+    }
+
+    bool perf = CacheMissCounter::instance().available();
+    Result result{ bm.name, iters, { }, { } };
+    for ( unsigned int r = 0; r < repetitions; ++r ) {
+      State state( iters );
+      bm.function( state );
+      double secs = state.get_seconds();
+      result.values.push_back( secs * 1e9 / state.get_iterations() );
+      auto counters = state.counters;
+      counters[ "allocs_per_iter" ] =
+        static_cast< double >( state.get_allocations() ) / state.get_iterations();
+      if ( perf ) {
+        counters[ "misses_per_iter" ] =
+          static_cast< double >( state.get_cache_misses() ) / state.get_iterations();
+      }
+      if ( state.get_items() != 0 ) {
+        counters[ "items_per_s" ] = state.get_items() / secs;
+        counters[ "ns_per_item" ] = secs * 1e9 / state.get_items();
+        counters[ "allocs_per_item" ] =
+          static_cast< double >( state.get_allocations() ) / state.get_items();
+        if ( perf ) {
+          counters[ "misses_per_item" ] =
+            static_cast< double >( state.get_cache_misses() ) / state.get_items();
+        }
+      }
+      for ( const auto& c : counters ) {
+        result.counters[ c.first ] += c.second / repetitions;
+      }
+    }
+    return result;
+  }
+
+    inline void
+  write_json( std::ostream& out, const std::string& program,
+      const std::vector< Result >& results )
+  {
+    out << "{" << std::endl
+        << "  \"context\": {" << std::endl
+        << "    \"program\": \"" << program << "\"" << std::endl
+        << "  }," << std::endl
+        << "  \"benchmarks\": [";
+    for ( std::size_t i = 0; i < results.size(); ++i ) {
+      const auto& res = results[ i ];
+      out << ( i == 0 ? "" : "," ) << std::endl
+          << "    {" << std::endl
+          << "      \"name\": \"" << res.name << "\"," << std::endl
+          << "      \"unit\": \"ns\"," << std::endl
+          << "      \"iterations\": " << res.iterations << "," << std::endl
+          << "      \"values\": [";
+      for ( std::size_t j = 0; j < res.values.size(); ++j ) {
+        out << ( j == 0 ? "" : ", " ) << std::fixed << std::setprecision( 3 )
+            << res.values[ j ];
+      }
+      out << "]," << std::endl << "      \"counters\": {";
+      std::size_t j = 0;
+      for ( const auto& c : res.counters ) {
+        out << ( j++ == 0 ? "" : "," ) << std::endl << "        \"" << c.first
+            << "\": " << std::setprecision( 6 ) << c.second;
+      }
+      out << std::endl << "      }" << std::endl << "    }";
+    }
+    out << std::endl << "  ]" << std::endl << "}" << std::endl;
+  }
+
+  /**
+   *  @brief  Extract a program-specific option from the command line.
+   *
+   *  @param  argc The number of arguments; updated if the option is found.
+   *  @param  argv The arguments; the option and its value are removed if found.
+   *  @param  name The option name; e.g. "--gcsa".
+   *  @param  value The option value; unchanged if the option is not given.
+   *  @return `true` if the option is found.
+   *
+   *  It should be called before `bench::main` for each option of the program.
+   */
+    inline bool
+  extract_option( int& argc, char* argv[], const std::string& name, std::string& value )
+  {
+    for ( int i = 1; i + 1 < argc; ++i ) {
+      if ( name != argv[ i ] ) continue;
+      value = argv[ i + 1 ];
+      for ( int j = i; j + 2 <= argc; ++j ) argv[ j ] = argv[ j + 2 ];
+      argc -= 2;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   *  @brief  Run the registered benchmarks according to the command line.
+   *
+   *  Supported arguments:
+   *    --filter REGEX     run only benchmarks whose name matches REGEX
+   *    --min-time SECS    minimum time of each repetition [default: 0.1]
+   *    --repetitions N    number of repetitions [default: 3]
+   *    --warmup N         number of unrecorded runs before repetitions [default: 1]
+   *    --json FILE        write the results to FILE in JSON format
+   *    --list             list the benchmark names and exit
+   */
+    inline int
+  main( int argc, char* argv[], const std::string& extra_usage="" )
+  {
+    std::string filter = ".*";
+    std::string json_filename;
+    double min_time = 0.1;
+    unsigned int repetitions = 3;
+    unsigned int warmup = 1;
+    bool list = false;
+    for ( int i = 1; i < argc; ++i ) {
+      std::string arg = argv[ i ];
+      auto next = [&]( ) -> std::string {
+        if ( i + 1 == argc ) throw std::runtime_error( "missing value for " + arg );
+        return argv[ ++i ];
+      };
+      if ( arg == "--filter" ) filter = next();
+      else if ( arg == "--min-time" ) min_time = std::stod( next() );
+      else if ( arg == "--repetitions" ) repetitions = std::stoul( next() );
+      else if ( arg == "--warmup" ) warmup = std::stoul( next() );
+      else if ( arg == "--json" ) json_filename = next();
+      else if ( arg == "--list" ) list = true;
+      else {
+        std::cerr << "Usage: " << argv[ 0 ] << " [--filter REGEX] [--min-time SECS]"
+                  << " [--repetitions N] [--warmup N] [--json FILE] [--list]"
+                  << extra_usage << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if ( repetitions == 0 ) repetitions = 1;
+
+    std::regex re( filter );
+    std::vector< Result > results;
+    for ( const auto& bm : registry() ) {
+      if ( !std::regex_search( bm.name, re ) ) continue;
+      if ( list ) {
+        std::cout << bm.name << std::endl;
+        continue;
+      }
+      results.push_back( run( bm, min_time, repetitions, warmup ) );
+      const auto& res = results.back();
+      std::cout << std::left << std::setw( 48 ) << res.name << std::right
+                << std::fixed << std::setprecision( 1 ) << std::setw( 14 )
+                << median( res.values ) << " ns" << std::setw( 12 ) << res.iterations;
+      for ( const auto& c : res.counters ) {
+        std::cout << "  " << c.first << "=" << std::setprecision( 4 )
+                  << std::defaultfloat << c.second << std::fixed;
+      }
+      std::cout << std::endl;
+    }
+
+    if ( !json_filename.empty() ) {
+      std::ofstream ofs( json_filename, std::ofstream::out );
+      if ( !ofs ) {
+        throw std::runtime_error( "could not open file '" + json_filename + "'" );
+      }
+      write_json( ofs, argv[ 0 ], results );
+    }
+    return EXIT_SUCCESS;
+  }
+}  /* -----  end of namespace bench  ----- */
+
+#endif  // HARNESS_H__
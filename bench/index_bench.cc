@@ -0,0 +1,252 @@
+/**
+ *    @file  index_bench.cc
+ *   @brief  Index query micro-benchmarks.
+ *
+ *  Measures `find`, `count` and `locate` queries against a resident GCSA2 index.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  15:30
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+
+#include <gcsa/gcsa.h>
+
+#include "locator.h"
+#include "kmer.h"
+#include "harness.h"
+#include "simulator.h"
+#include "kmer_graph.h"
+
+
+constexpr std::size_t POOL_SIZE = 8192;    /**< @brief Number of sampled k-mers. */
+
+Locator locator;    /**< @brief The index loaded once for all benchmarks. */
+const gcsa::GCSA& resident_index = locator.get_index();
+
+/**
+ *  @brief  Sample a pool of k-mers from a source.
+ */
+template< typename TSource >
+    inline std::vector< std::string >
+  sample_kmers( const TSource& source, unsigned int k, std::size_t count )
+  {
+    std::mt19937_64 rng( k );
+    std::vector< std::string > kmers;
+    std::string kmer;
+    std::size_t attempts = 0;
+    while ( kmers.size() < count && attempts++ < count * 100 ) {
+      if ( source.sample( rng, k, kmer ) ) kmers.push_back( kmer );
+    }
+    return kmers;
+  }
+
+/**
+ *  @brief  Source of uniformly random k-mers.
+ */
+struct RandomSource {
+    inline bool
+  sample( std::mt19937_64& rng, std::size_t len, std::string& fragment ) const
+  {
+    std::uniform_int_distribution< int > base( 0, 3 );
+    fragment.clear();
+    for ( std::size_t i = 0; i < len; ++i ) fragment += "ACGT"[ base( rng ) ];
+    return true;
+  }
+};
+
+/**
+ *  @brief  Select the most repetitive k-mers of the pool.
+ *
+ *  Sorts the pool by the number of occurrences of the k-mers in the index in
+ *  descending order and keeps the top tenth.
+ */
+  inline std::vector< std::string >
+repeat_kmers( std::vector< std::string > pool )
+{
+  typedef std::pair< gcsa::size_type, std::size_t > count_type;
+  std::vector< count_type > counts;
+  for ( std::size_t i = 0; i < pool.size(); ++i ) {
+    auto range = resident_index.find( pool[ i ] );
+    gcsa::size_type count = 0;
+    if ( !gcsa::Range::empty( range ) ) count = resident_index.count( range );
+    counts.emplace_back( count, i );
+  }
+  std::sort( counts.begin(), counts.end(), std::greater< count_type >() );
+  std::vector< std::string > kmers;
+  for ( std::size_t i = 0; i < std::max< std::size_t >( 1, pool.size() / 10 ); ++i ) {
+    if ( i == counts.size() ) break;
+    kmers.push_back( pool[ counts[ i ].second ] );
+  }
+  return kmers;
+}
+
+/**
+ *  @brief  Register `find`, `count` and `locate` benchmarks for a set of k-mers.
+ *
+ *  Each iteration runs the query for a batch of `batch` k-mers drawn cyclically from
+ *  the set, so `ns_per_item` is the time per query. The `locate-hits` and
+ *  `locate-visit` benchmarks measure the batch and visitor APIs of `Locator`, which
+ *  include `find`. `find-packed` runs the unrolled backward search of the k-mers
+ *  packed in words, for the packed seed lengths.
+ */
+  inline void
+register_queries( const std::string& workload, unsigned int k,
+    std::shared_ptr< std::vector< std::string > > kmers )
+{
+  if ( kmers->empty() ) return;
+  auto ranges = std::make_shared< std::vector< gcsa::range_type > >();
+  for ( const auto& kmer : *kmers ) {
+    auto range = resident_index.find( kmer );
+    if ( !gcsa::Range::empty( range ) ) ranges->push_back( range );
+  }
+
+  for ( std::size_t batch : { 1, 64, 4096 } ) {
+    std::string suffix = "/" + workload + "/k:" + std::to_string( k ) + "/batch:"
+      + std::to_string( batch );
+    bench::register_benchmark( "find" + suffix, [=]( bench::State& state ) {
+        std::size_t next = 0;
+        while ( state.keep_running() ) {
+          for ( std::size_t i = 0; i < batch; ++i ) {
+            bench::do_not_optimize( resident_index.find( ( *kmers )[ next ] ) );
+            if ( ++next == kmers->size() ) next = 0;
+          }
+        }
+        state.set_items_processed( state.get_iterations() * batch );
+        });
+    dispatch_packed( k, [&]( auto kk ) {
+        constexpr unsigned int K = decltype( kk )::value;
+        auto packed = std::make_shared< std::vector< std::uint64_t > >();
+        for ( const auto& kmer : *kmers ) {
+          if ( kmer.find_first_not_of( "ACGTacgt" ) != std::string::npos ) continue;
+          packed->push_back( PackedKmer< K >::encode( kmer ) );
+        }
+        if ( packed->empty() ) return;
+        bench::register_benchmark( "find-packed" + suffix, [=]( bench::State& state ) {
+            std::size_t next = 0;
+            while ( state.keep_running() ) {
+              for ( std::size_t i = 0; i < batch; ++i ) {
+                bench::do_not_optimize( locator.find< K >( ( *packed )[ next ] ) );
+                if ( ++next == packed->size() ) next = 0;
+              }
+            }
+            state.set_items_processed( state.get_iterations() * batch );
+            } );
+        } );
+    if ( ranges->empty() ) continue;
+    bench::register_benchmark( "count" + suffix, [=]( bench::State& state ) {
+        std::size_t next = 0;
+        while ( state.keep_running() ) {
+          for ( std::size_t i = 0; i < batch; ++i ) {
+            bench::do_not_optimize( resident_index.count( ( *ranges )[ next ] ) );
+            if ( ++next == ranges->size() ) next = 0;
+          }
+        }
+        state.set_items_processed( state.get_iterations() * batch );
+        });
+    bench::register_benchmark( "locate" + suffix, [=]( bench::State& state ) {
+        std::vector< gcsa::node_type > results;
+        std::size_t next = 0;
+        std::uint64_t occs = 0;
+        while ( state.keep_running() ) {
+          for ( std::size_t i = 0; i < batch; ++i ) {
+            resident_index.locate( ( *ranges )[ next ], results );
+            occs += results.size();
+            if ( ++next == ranges->size() ) next = 0;
+          }
+        }
+        state.set_items_processed( state.get_iterations() * batch );
+        state.counters[ "occs_per_query" ] =
+          static_cast< double >( occs ) / ( state.get_iterations() * batch );
+        });
+    bench::register_benchmark( "locate-visit" + suffix, [=]( bench::State& state ) {
+        Locator::nodes_type buffer;
+        std::size_t next = 0;
+        std::uint64_t occs = 0;
+        while ( state.keep_running() ) {
+          for ( std::size_t i = 0; i < batch; ++i ) {
+            auto pattern = kmers->begin() + next;
+            locator.visit( pattern, pattern + 1,
+                [&occs]( Locator::size_type, Locator::node_type ) { ++occs; }, buffer );
+            if ( ++next == kmers->size() ) next = 0;
+          }
+        }
+        state.set_items_processed( state.get_iterations() * batch );
+        state.counters[ "occs_per_query" ] =
+          static_cast< double >( occs ) / ( state.get_iterations() * batch );
+        });
+    bench::register_benchmark( "locate-hits" + suffix, [=]( bench::State& state ) {
+        /* The k-mers repeated cyclically such that any batch is a contiguous slice. */
+        std::vector< std::string > patterns;
+        for ( std::size_t i = 0; i < kmers->size() + batch; ++i ) {
+          patterns.push_back( ( *kmers )[ i % kmers->size() ] );
+        }
+        Hits hits;
+        std::size_t next = 0;
+        std::uint64_t occs = 0;
+        while ( state.keep_running() ) {
+          locator.locate( patterns.begin() + next, patterns.begin() + next + batch, hits );
+          occs += hits.nodes.size();
+          next = ( next + batch ) % kmers->size();
+        }
+        state.set_items_processed( state.get_iterations() * batch );
+        state.counters[ "occs_per_query" ] =
+          static_cast< double >( occs ) / ( state.get_iterations() * batch );
+        });
+  }
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  std::string gcsa_name = "test/data/complex/c.gcsa";
+  std::string graph_name;
+  std::string fasta_name;
+  std::string kvalues = "12,16,20,24,32";
+  bench::extract_option( argc, argv, "--gcsa", gcsa_name );
+  bench::extract_option( argc, argv, "--graph", graph_name );
+  bench::extract_option( argc, argv, "--fasta", fasta_name );
+  bench::extract_option( argc, argv, "--k", kvalues );
+
+  locator.load( gcsa_name );
+
+  std::unique_ptr< KmerGraph > graph;
+  std::unique_ptr< FastaSource > fasta;
+  if ( !graph_name.empty() ) graph.reset( new KmerGraph( graph_name ) );
+  if ( !fasta_name.empty() ) fasta.reset( new FastaSource( fasta_name ) );
+
+  std::size_t pos = 0;
+  while ( pos < kvalues.size() ) {
+    std::size_t end = std::min( kvalues.find( ',', pos ), kvalues.size() );
+    unsigned int k = std::stoul( kvalues.substr( pos, end - pos ) );
+    pos = end + 1;
+    if ( k > resident_index.order() ) continue;
+
+    register_queries( "random", k, std::make_shared< std::vector< std::string > >(
+          sample_kmers( RandomSource(), k, POOL_SIZE ) ) );
+    std::vector< std::string > pool;
+    if ( graph ) pool = sample_kmers( *graph, k, POOL_SIZE );
+    else if ( fasta ) pool = sample_kmers( *fasta, k, POOL_SIZE );
+    if ( pool.empty() ) continue;
+    register_queries( graph ? "graph" : "fasta", k,
+        std::make_shared< std::vector< std::string > >( pool ) );
+    register_queries( "repeat", k,
+        std::make_shared< std::vector< std::string > >( repeat_kmers( pool ) ) );
+  }
+
+  return bench::main( argc, argv,
+      " [--gcsa GCSA] [--graph GRAPH | --fasta FASTA] [--k K1,K2,...]" );
+}
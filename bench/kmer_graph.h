@@ -0,0 +1,137 @@
+/**
+ *    @file  kmer_graph.h
+ *   @brief  GCSA2 input graph.
+ *
+ *  Loads the k-mer graph from which a GCSA2 index is built (`.graph` file).
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  12:40
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef KMER_GRAPH_H__
+#define KMER_GRAPH_H__
+
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <gcsa/files.h>
+
+
+/**
+ *  @brief  The k-mer graph used as GCSA2 input.
+ *
+ *  Each k-mer is a path of `k` characters in the variation graph starting at node
+ *  `from`; the path continues at node `to`. The k-mers are kept sorted by their
+ *  start node, so that all k-mers starting at a node can be found by binary search.
+ */
+class KmerGraph
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef gcsa::node_type node_type;
+    typedef std::vector< std::size_t >::const_iterator iterator;
+    /* ====================  LIFECYCLE     ======================================= */
+    KmerGraph( const std::string& filename )
+    {
+      gcsa::Alphabet alpha;
+      gcsa::InputGraph graph( { filename }, true, alpha );
+      std::vector< gcsa::KMer > kmers;
+      graph.read( kmers );
+      this->k = graph.k();
+      std::sort( kmers.begin(), kmers.end(),
+          []( const gcsa::KMer& a, const gcsa::KMer& b ) { return a.from < b.from; } );
+      this->froms.reserve( kmers.size() );
+      this->tos.reserve( kmers.size() );
+      this->labels.reserve( kmers.size() * this->k );
+      for ( const auto& kmer : kmers ) {
+        this->froms.push_back( kmer.from );
+        this->tos.push_back( kmer.to );
+        this->labels += gcsa::Key::decode( kmer.key, this->k, alpha );
+      }
+    }  /* -----  end of method KmerGraph  (constructor)  ----- */
+    /* ====================  ACCESSORS     ======================================= */
+      inline std::size_t
+    size( ) const
+    {
+      return this->froms.size();
+    }
+
+      inline std::size_t
+    kmer_length( ) const
+    {
+      return this->k;
+    }
+
+      inline node_type
+    from( std::size_t i ) const
+    {
+      return this->froms[ i ];
+    }
+
+      inline node_type
+    to( std::size_t i ) const
+    {
+      return this->tos[ i ];
+    }
+
+      inline const char*
+    label( std::size_t i ) const
+    {
+      return this->labels.data() + i * this->k;
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Indices of k-mers starting at `node` as a half-open range.
+     */
+      inline std::pair< std::size_t, std::size_t >
+    kmers_from( node_type node ) const
+    {
+      auto range = std::equal_range( this->froms.begin(), this->froms.end(), node );
+      return { range.first - this->froms.begin(), range.second - this->froms.begin() };
+    }
+
+    /**
+     *  @brief  Sample a fragment of length `len` by a random walk in the graph.
+     *
+     *  @param  rng The random number generator.
+     *  @param  len The length of the fragment.
+     *  @param  fragment The sampled fragment.
+     *  @return `true` if the walk reached length `len` without hitting a source or
+     *          sink marker or a non-nucleotide character.
+     */
+      inline bool
+    sample( std::mt19937_64& rng, std::size_t len, std::string& fragment ) const
+    {
+      if ( this->size() == 0 ) return false;
+      std::uniform_int_distribution< std::size_t > dist( 0, this->size() - 1 );
+      std::size_t i = dist( rng );
+      fragment.clear();
+      while ( true ) {
+        fragment.append( this->label( i ), this->k );
+        if ( fragment.size() >= len ) break;
+        auto next = this->kmers_from( this->to( i ) );
+        if ( next.first == next.second ) return false;
+        i = std::uniform_int_distribution< std::size_t >( next.first,
+            next.second - 1 )( rng );
+      }
+      fragment.resize( len );
+      return fragment.find_first_not_of( "ACGT" ) == std::string::npos;
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    std::size_t k;
+    std::vector< node_type > froms;
+    std::vector< node_type > tos;
+    std::string labels;
+};  /* -----  end of class KmerGraph  ----- */
+
+#endif  // KMER_GRAPH_H__
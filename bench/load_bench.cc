@@ -0,0 +1,398 @@
+/**
+ *    @file  load_bench.cc
+ *   @brief  Index load benchmark.
+ *
+ *  Measures loading the GCSA2 index by different methods with cold and warm page
+ *  cache: time to load, to the first answered query and to full query throughput.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  21:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <streambuf>
+#include <istream>
+
+#include <gcsa/gcsa.h>
+
+#include "harness.h"
+#include "seed.h"
+
+
+typedef std::chrono::steady_clock clock_type;
+
+/**
+ *  @brief  Read-only memory mapping of a whole file.
+ */
+class MappedFile
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    MappedFile( const std::string& filename )
+    {
+      this->fd = ::open( filename.c_str(), O_RDONLY );
+      if ( this->fd == -1 ) {
+        throw std::runtime_error( "could not open file '" + filename + "'" );
+      }
+      struct stat st;
+      if ( ::fstat( this->fd, &st ) == -1 ) {
+        ::close( this->fd );
+        throw std::runtime_error( "could not stat file '" + filename + "'" );
+      }
+      this->len = st.st_size;
+      this->addr = ::mmap( nullptr, this->len, PROT_READ, MAP_PRIVATE, this->fd, 0 );
+      if ( this->addr == MAP_FAILED ) {
+        ::close( this->fd );
+        throw std::runtime_error( "could not map file '" + filename + "'" );
+      }
+      ::madvise( this->addr, this->len, MADV_SEQUENTIAL );
+    }
+
+    ~MappedFile( )
+    {
+      ::munmap( this->addr, this->len );
+      ::close( this->fd );
+    }
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+    /* ====================  ACCESSORS     ======================================= */
+      inline const char*
+    data( ) const
+    {
+      return static_cast< const char* >( this->addr );
+    }
+
+      inline std::size_t
+    size( ) const
+    {
+      return this->len;
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    int fd;
+    void* addr;
+    std::size_t len;
+};  /* -----  end of class MappedFile  ----- */
+
+/**
+ *  @brief  Input stream buffer reading directly from memory.
+ *
+ *  The whole buffer is the get area, so `std::istream::read` copies from the
+ *  mapping without an intermediate buffer or system calls.
+ */
+class MemoryStreambuf : public std::streambuf
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    MemoryStreambuf( const char* data, std::size_t size )
+    {
+      char* begin = const_cast< char* >( data );
+      this->setg( begin, begin, begin + size );
+    }
+  protected:
+    /* ====================  METHODS       ======================================= */
+      inline pos_type
+    seekoff( off_type off, std::ios_base::seekdir dir,
+        std::ios_base::openmode which=std::ios_base::in ) override
+    {
+      off_type pos = off;
+      if ( dir == std::ios_base::cur ) pos += this->gptr() - this->eback();
+      else if ( dir == std::ios_base::end ) pos += this->egptr() - this->eback();
+      return this->seekpos( pos, which );
+    }
+
+      inline pos_type
+    seekpos( pos_type pos, std::ios_base::openmode which=std::ios_base::in ) override
+    {
+      if ( !( which & std::ios_base::in ) || pos < 0
+          || pos > this->egptr() - this->eback() ) {
+        return pos_type( off_type( -1 ) );
+      }
+      this->setg( this->eback(), this->eback() + pos, this->egptr() );
+      return pos;
+    }
+};  /* -----  end of class MemoryStreambuf  ----- */
+
+/**
+ *  @brief  Drop the file from the page cache.
+ *
+ *  `POSIX_FADV_DONTNEED` only evicts clean pages not mapped by any process, so dirty
+ *  pages of a freshly written index are flushed first; the fraction of the file still
+ *  cached is reported separately.
+ */
+  inline void
+drop_cache( const std::string& filename )
+{
+  int fd = ::open( filename.c_str(), O_RDONLY );
+  if ( fd == -1 ) throw std::runtime_error( "could not open file '" + filename + "'" );
+  ::fdatasync( fd );
+  ::posix_fadvise( fd, 0, 0, POSIX_FADV_DONTNEED );
+  ::close( fd );
+}
+
+/**
+ *  @brief  Bring the whole file into the page cache by reading it.
+ */
+  inline void
+warm_cache( const std::string& filename )
+{
+  std::ifstream ifs( filename, std::ifstream::in | std::ifstream::binary );
+  std::vector< char > buffer( 1 << 20 );
+  while ( ifs.read( buffer.data(), buffer.size() ) || ifs.gcount() != 0 );
+}
+
+/**
+ *  @brief  Fraction of the pages of the file resident in the page cache.
+ */
+  inline double
+cached_fraction( const std::string& filename )
+{
+  MappedFile file( filename );
+  long page = ::sysconf( _SC_PAGESIZE );
+  std::size_t npages = ( file.size() + page - 1 ) / page;
+  if ( npages == 0 ) return 1;
+  std::vector< unsigned char > residency( npages );
+  if ( ::mincore( const_cast< char* >( file.data() ), file.size(), residency.data() ) ) {
+    return -1;
+  }
+  std::size_t resident = 0;
+  for ( auto r : residency ) resident += r & 1;
+  return static_cast< double >( resident ) / npages;
+}
+
+/**
+ *  @brief  Load the index by the given method.
+ *
+ *  "stream" reads the file by a `std::ifstream`; "mmap" maps the file and reads the
+ *  index from the mapping through `MemoryStreambuf`.
+ */
+  inline void
+load_index( gcsa::GCSA& index, const std::string& filename, const std::string& method )
+{
+  if ( method == "stream" ) {
+    std::ifstream ifs( filename, std::ifstream::in | std::ifstream::binary );
+    if ( !ifs ) throw std::runtime_error( "could not open file '" + filename + "'" );
+    index.load( ifs );
+  }
+  else if ( method == "mmap" ) {
+    MappedFile file( filename );
+    MemoryStreambuf buf( file.data(), file.size() );
+    std::istream is( &buf );
+    index.load( is );
+  }
+  else {
+    throw std::runtime_error( "unknown load method '" + method + "'" );
+  }
+}
+
+/**
+ *  @brief  Timings of one load.
+ */
+struct LoadTimes {
+  double load;              /**< @brief Until `load` returns. */
+  double first_query;       /**< @brief Until the first query is answered. */
+  double full_throughput;   /**< @brief Until a window reaches full throughput. */
+  double steady_qps;        /**< @brief Queries per second at full throughput. */
+};
+
+/**
+ *  @brief  Load the index and query it in windows.
+ *
+ *  All times are in nanoseconds from the start of the load. The steady throughput is
+ *  the median throughput of the second half of the windows; full throughput is
+ *  reached at the end of the first window achieving `full` times of it.
+ */
+  inline LoadTimes
+measure( const std::string& filename, const std::string& method,
+    const std::vector< std::string >& patterns, std::size_t window,
+    unsigned int nof_windows, double full )
+{
+  gcsa::GCSA index;
+  std::vector< gcsa::node_type > results;
+  auto query = [&]( const std::string& pattern ) {
+    auto range = index.find( pattern );
+    if ( !gcsa::Range::empty( range ) ) index.locate( range, results );
+    bench::do_not_optimize( results.data() );
+  };
+  auto since = []( clock_type::time_point start ) {
+    return std::chrono::duration< double, std::nano >( clock_type::now() - start ).count();
+  };
+
+  LoadTimes times;
+  auto start = clock_type::now();
+  load_index( index, filename, method );
+  times.load = since( start );
+  query( patterns[ 0 ] );
+  times.first_query = since( start );
+
+  std::vector< double > ends;
+  std::vector< double > qps;
+  std::size_t next = 1;
+  for ( unsigned int w = 0; w < nof_windows; ++w ) {
+    auto wstart = clock_type::now();
+    for ( std::size_t i = 0; i < window; ++i ) {
+      query( patterns[ next ] );
+      if ( ++next == patterns.size() ) next = 0;
+    }
+    qps.push_back( window / std::chrono::duration< double >(
+          clock_type::now() - wstart ).count() );
+    ends.push_back( since( start ) );
+  }
+  times.steady_qps = bench::median(
+      std::vector< double >( qps.begin() + qps.size() / 2, qps.end() ) );
+  times.full_throughput = ends.back();
+  for ( std::size_t w = 0; w < qps.size(); ++w ) {
+    if ( qps[ w ] >= full * times.steady_qps ) {
+      times.full_throughput = ends[ w ];
+      break;
+    }
+  }
+  return times;
+}
+
+  inline std::vector< std::string >
+split( const std::string& str )
+{
+  std::vector< std::string > tokens;
+  std::size_t pos = 0;
+  while ( pos <= str.size() ) {
+    std::size_t end = std::min( str.find( ',', pos ), str.size() );
+    if ( end > pos ) tokens.push_back( str.substr( pos, end - pos ) );
+    pos = end + 1;
+  }
+  return tokens;
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  std::string gcsa_name = "test/data/complex/c.gcsa";
+  std::string reads_name = "test/data/complex/reads_n100l100e0i0.seq";
+  std::string methods = "stream,mmap";
+  std::string caches = "cold,warm";
+  std::string json_filename;
+  unsigned int k = 16;
+  std::size_t window = 2000;
+  unsigned int nof_windows = 20;
+  unsigned int repetitions = 3;
+  double full = 0.9;
+  for ( int i = 1; i < argc; ++i ) {
+    std::string arg = argv[ i ];
+    auto next = [&]( ) -> std::string {
+      if ( i + 1 == argc ) throw std::runtime_error( "missing value for " + arg );
+      return argv[ ++i ];
+    };
+    if ( arg == "--gcsa" ) gcsa_name = next();
+    else if ( arg == "--reads" ) reads_name = next();
+    else if ( arg == "--methods" ) methods = next();
+    else if ( arg == "--cache" ) caches = next();
+    else if ( arg == "--k" ) k = std::stoul( next() );
+    else if ( arg == "--window" ) window = std::stoull( next() );
+    else if ( arg == "--windows" ) nof_windows = std::stoul( next() );
+    else if ( arg == "--full" ) full = std::stod( next() );
+    else if ( arg == "--repetitions" ) repetitions = std::stoul( next() );
+    else if ( arg == "--json" ) json_filename = next();
+    else {
+      std::cerr << "Usage: " << argv[ 0 ] << " [--gcsa GCSA] [--reads READS] [--k K]"
+                << " [--methods stream,mmap] [--cache cold,warm] [--window N]"
+                << " [--windows W] [--full FRACTION] [--repetitions N] [--json FILE]"
+                << std::endl << std::endl
+                << "Load the index by each method after dropping it from (cold) or"
+                << std::endl
+                << "reading it into (warm) the page cache, then query the k-mers of"
+                << std::endl
+                << "READS in W windows of N queries. Reports time to load, to the first"
+                << std::endl
+                << "answered query and to the first window whose throughput is at least"
+                << std::endl
+                << "FRACTION [default: 0.9] of the steady throughput." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if ( repetitions == 0 ) repetitions = 1;
+  if ( nof_windows == 0 ) nof_windows = 1;
+
+  std::vector< std::string > reads;
+  {
+    std::ifstream ifs( reads_name, std::ifstream::in );
+    if ( !ifs ) throw std::runtime_error( "could not open file '" + reads_name + "'" );
+    std::string line;
+    while ( std::getline( ifs, line ) ) {
+      if ( line.size() >= k ) reads.push_back( line );
+    }
+  }
+  std::vector< std::string > patterns;
+  seeding( patterns, reads, k, GreedyOverlapping() );
+  if ( patterns.empty() ) {
+    throw std::runtime_error( "no k-mers of length " + std::to_string( k ) + " in '"
+        + reads_name + "'" );
+  }
+  std::shuffle( patterns.begin(), patterns.end(), std::mt19937_64( k ) );
+
+  std::vector< bench::Result > results;
+  std::cout << std::left << std::setw( 8 ) << "method" << std::setw( 6 ) << "cache"
+            << std::right << std::setw( 9 ) << "cached" << std::setw( 12 ) << "load ms"
+            << std::setw( 15 ) << "1st query ms" << std::setw( 15 ) << "full tput ms"
+            << std::setw( 14 ) << "steady q/s" << std::endl;
+  for ( const auto& method : split( methods ) ) {
+    for ( const auto& cache : split( caches ) ) {
+      if ( cache != "cold" && cache != "warm" ) {
+        throw std::runtime_error( "unknown cache state '" + cache + "'" );
+      }
+      std::string prefix = "load/" + method + "/" + cache + "/";
+      bench::Result load{ prefix + "load", 1, { }, { } };
+      bench::Result first{ prefix + "first_query", 1, { }, { } };
+      bench::Result tput{ prefix + "full_throughput", 1, { }, { } };
+      for ( unsigned int r = 0; r < repetitions; ++r ) {
+        if ( cache == "cold" ) drop_cache( gcsa_name );
+        else warm_cache( gcsa_name );
+        double cached = cached_fraction( gcsa_name );
+        LoadTimes times = measure( gcsa_name, method, patterns, window, nof_windows,
+            full );
+        load.values.push_back( times.load );
+        first.values.push_back( times.first_query );
+        tput.values.push_back( times.full_throughput );
+        for ( auto res : { &load, &first, &tput } ) {
+          res->counters[ "cached_fraction" ] += cached / repetitions;
+          res->counters[ "steady_queries_per_s" ] += times.steady_qps / repetitions;
+        }
+        std::cout << std::left << std::setw( 8 ) << method << std::setw( 6 ) << cache
+                  << std::right << std::fixed << std::setprecision( 2 ) << std::setw( 9 )
+                  << cached << std::setprecision( 1 ) << std::setw( 12 )
+                  << times.load / 1e6 << std::setw( 15 ) << times.first_query / 1e6
+                  << std::setw( 15 ) << times.full_throughput / 1e6
+                  << std::setprecision( 0 ) << std::setw( 14 ) << times.steady_qps
+                  << std::endl;
+      }
+      results.push_back( load );
+      results.push_back( first );
+      results.push_back( tput );
+    }
+  }
+
+  if ( !json_filename.empty() ) {
+    std::ofstream ofs( json_filename, std::ofstream::out );
+    if ( !ofs ) {
+      throw std::runtime_error( "could not open file '" + json_filename + "'" );
+    }
+    bench::write_json( ofs, argv[ 0 ], results );
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/**
+ *    @file  output_bench.cc
+ *   @brief  Output throughput benchmark.
+ *
+ *  Measures the throughput of the output writers for synthetic occurrence streams.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  20:15
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+#include <omp.h>
+
+#include "output.h"
+
+
+typedef std::chrono::steady_clock clock_type;
+
+/**
+ *  @brief  Synthetic occurrence stream of one thread.
+ *
+ *  The number of occurrences per seed is geometrically distributed with the given
+ *  mean, so a few seeds are highly repetitive; nodes are random positions in a graph
+ *  of about a billion nodes.
+ */
+struct HitStream {
+  std::vector< std::uint64_t > nodes;
+  std::vector< std::size_t > bounds;    /**< @brief Occurrences of seed i are in [bounds[i], bounds[i+1]). */
+
+  HitStream( std::uint64_t seed, std::size_t nof_hits, double mean_occs )
+  {
+    std::mt19937_64 rng( seed );
+    std::geometric_distribution< std::size_t > occs( 1.0 / mean_occs );
+    std::uniform_int_distribution< std::uint64_t > id( 1, 1000000000 );
+    std::uniform_int_distribution< std::uint64_t > offset( 0, 31 );
+    std::bernoulli_distribution rc( 0.5 );
+    this->nodes.reserve( nof_hits );
+    this->bounds.push_back( 0 );
+    while ( this->nodes.size() < nof_hits ) {
+      std::size_t n = std::min( occs( rng ) + 1, nof_hits - this->nodes.size() );
+      for ( std::size_t i = 0; i < n; ++i ) {
+        this->nodes.push_back( ( id( rng ) << ( NodeCodec::OFFSET_BITS + 1 ) )
+            | ( rc( rng ) ? NodeCodec::ORIENTATION_MASK : 0 ) | offset( rng ) );
+      }
+      this->bounds.push_back( this->nodes.size() );
+    }
+  }
+};
+
+/**
+ *  @brief  Range of occurrences of a seed as a container for `Writer::write`.
+ */
+struct NodeSpan {
+  const std::uint64_t* first;
+  const std::uint64_t* last;
+  const std::uint64_t* begin( ) const { return this->first; }
+  const std::uint64_t* end( ) const { return this->last; }
+};
+
+struct Result {
+  std::uint64_t hits;
+  std::uint64_t bytes;
+  double seconds;
+};
+
+/**
+ *  @brief  Write the streams by `threads` threads each with its own writer and file.
+ *
+ *  If `rate` is non-zero, each thread throttles itself to `rate` hits per second.
+ */
+  inline Result
+run( const std::vector< HitStream >& streams, const std::string& format, int level,
+    unsigned int threads, double rate, const std::string& dir )
+{
+  /* Writers are built before the parallel region and errors in it are raised after
+   * it, as exceptions cannot leave the region. */
+  std::vector< std::string > filenames;
+  std::vector< std::exception_ptr > errors( threads );
+  std::vector< std::ofstream > files( threads );
+  std::vector< std::unique_ptr< AnyWriter > > writers;
+  for ( unsigned int tid = 0; tid < threads; ++tid ) {
+    filenames.push_back( dir.empty() ? "/dev/null"
+        : dir + "/output_bench." + std::to_string( tid ) + "." + format );
+    files[ tid ].open( filenames[ tid ], std::ofstream::out | std::ofstream::binary );
+    if ( !files[ tid ] ) {
+      throw std::runtime_error( "could not open file '" + filenames[ tid ] + "'" );
+    }
+    writers.emplace_back( new AnyWriter( files[ tid ], format, level ) );
+  }
+  std::uint64_t hits = 0;
+  auto start = clock_type::now();
+#pragma omp parallel num_threads( threads ) reduction( +:hits )
+  {
+    unsigned int tid = omp_get_thread_num();
+    const HitStream& stream = streams[ tid ];
+    AnyWriter& writer = *writers[ tid ];
+    auto tstart = clock_type::now();
+    try {
+      for ( std::size_t i = 0; i + 1 < stream.bounds.size(); ++i ) {
+        const std::uint64_t* data = stream.nodes.data();
+        writer.write( i,
+            NodeSpan{ data + stream.bounds[ i ], data + stream.bounds[ i + 1 ] } );
+        if ( rate > 0 && i % 64 == 0 ) {
+          std::this_thread::sleep_until( tstart + std::chrono::duration_cast<
+              clock_type::duration >( std::chrono::duration< double >(
+                  stream.bounds[ i + 1 ] / rate ) ) );
+        }
+      }
+    }
+    catch ( ... ) {
+      errors[ tid ] = std::current_exception();
+    }
+    hits += stream.nodes.size();
+  }
+  for ( const auto& error : errors ) {
+    if ( error ) std::rethrow_exception( error );
+  }
+  /* The last blocks buffered by the writers are written as part of the run. */
+  std::uint64_t bytes = 0;
+  for ( unsigned int tid = 0; tid < threads; ++tid ) {
+    if ( !writers[ tid ]->close() ) {
+      throw std::runtime_error( "could not write file '" + filenames[ tid ] + "'" );
+    }
+    bytes += writers[ tid ]->bytes_written();
+  }
+  double secs = std::chrono::duration< double >( clock_type::now() - start ).count();
+  writers.clear();
+  for ( const auto& filename : filenames ) {
+    if ( !dir.empty() ) std::remove( filename.c_str() );
+  }
+  return { hits, bytes, secs };
+}
+
+  inline std::vector< std::string >
+split( const std::string& str )
+{
+  std::vector< std::string > tokens;
+  std::size_t pos = 0;
+  while ( pos <= str.size() ) {
+    std::size_t end = std::min( str.find( ',', pos ), str.size() );
+    if ( end > pos ) tokens.push_back( str.substr( pos, end - pos ) );
+    pos = end + 1;
+  }
+  return tokens;
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  std::string formats = "tsv,binary,compressed";
+  std::string levels = "1,6";
+  std::string threads_list = "1,2,4";
+  std::string dir;
+  std::string csv_filename;
+  std::size_t nof_hits = 4000000;
+  double mean_occs = 8;
+  double rate = 0;
+  for ( int i = 1; i < argc; ++i ) {
+    std::string arg = argv[ i ];
+    auto next = [&]( ) -> std::string {
+      if ( i + 1 == argc ) throw std::runtime_error( "missing value for " + arg );
+      return argv[ ++i ];
+    };
+    if ( arg == "--formats" ) formats = next();
+    else if ( arg == "--levels" ) levels = next();
+    else if ( arg == "--threads" ) threads_list = next();
+    else if ( arg == "--hits" ) nof_hits = std::stoull( next() );
+    else if ( arg == "--mean-occs" ) mean_occs = std::stod( next() );
+    else if ( arg == "--rate" ) rate = std::stod( next() );
+    else if ( arg == "--dir" ) dir = next();
+    else if ( arg == "--csv" ) csv_filename = next();
+    else {
+      std::cerr << "Usage: " << argv[ 0 ] << " [--formats tsv,binary,compressed]"
+                << " [--levels L1,L2,...] [--threads T1,T2,...] [--hits N]"
+                << " [--mean-occs M] [--rate HITS_PER_S] [--dir DIR] [--csv FILE]"
+                << std::endl << std::endl
+                << "Write N synthetic hits per thread with M occurrences per seed on"
+                << std::endl
+                << "average into each writer, one file per thread in DIR [default:"
+                << std::endl
+                << "/dev/null], optionally throttled to a rate per thread." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if ( mean_occs < 1 ) mean_occs = 1;
+
+  unsigned int max_threads = 1;
+  for ( const auto& t : split( threads_list ) ) {
+    max_threads = std::max< unsigned int >( max_threads, std::stoul( t ) );
+  }
+  std::vector< HitStream > streams;
+  for ( unsigned int t = 0; t < max_threads; ++t ) {
+    streams.emplace_back( t, nof_hits, mean_occs );
+  }
+
+  std::ofstream csv;
+  if ( !csv_filename.empty() ) {
+    csv.open( csv_filename, std::ofstream::out );
+    if ( !csv ) {
+      throw std::runtime_error( "could not open file '" + csv_filename + "'" );
+    }
+    csv << "format,level,threads,hits,bytes,seconds,mb_per_s,hits_per_s" << std::endl;
+  }
+  std::cout << std::left << std::setw( 12 ) << "format" << std::right << std::setw( 6 )
+            << "level" << std::setw( 8 ) << "threads" << std::setw( 14 ) << "bytes/hit"
+            << std::setw( 12 ) << "MB/s" << std::setw( 14 ) << "hits/s" << std::endl;
+  for ( const auto& format : split( formats ) ) {
+    std::vector< std::string > lvls = { "0" };
+    if ( format == "compressed" ) lvls = split( levels );
+    for ( const auto& lvl : lvls ) {
+      for ( const auto& t : split( threads_list ) ) {
+        unsigned int threads = std::stoul( t );
+        Result res = run( streams, format, std::stoi( lvl ), threads, rate, dir );
+        double mbps = res.bytes / res.seconds / 1e6;
+        double hps = res.hits / res.seconds;
+        std::cout << std::left << std::setw( 12 ) << format << std::right
+                  << std::setw( 6 ) << lvl << std::setw( 8 ) << threads << std::fixed
+                  << std::setprecision( 2 ) << std::setw( 14 )
+                  << static_cast< double >( res.bytes ) / res.hits << std::setw( 12 )
+                  << mbps << std::setprecision( 0 ) << std::setw( 14 ) << hps
+                  << std::endl;
+        if ( csv.is_open() ) {
+          csv << format << "," << lvl << "," << threads << "," << res.hits << ","
+              << res.bytes << "," << std::setprecision( 6 ) << res.seconds << ","
+              << mbps << "," << hps << std::endl;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
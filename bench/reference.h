@@ -0,0 +1,90 @@
+/**
+ *    @file  reference.h
+ *   @brief  Reference k-mer matcher.
+ *
+ *  Brute-force matching of patterns against the GCSA2 input graph.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  18:20
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef REFERENCE_H__
+#define REFERENCE_H__
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "kmer_graph.h"
+
+
+/**
+ *  @brief  Brute-force matcher over the k-mer graph.
+ *
+ *  A pattern occurs at node `v` if it is spelled by a walk starting at `v`; i.e. by
+ *  a chain of k-mers each starting at the `to` node of the previous one. Every k-mer
+ *  of the graph is tried as the first link of the chain, so the occurrences are
+ *  found by naive enumeration without any index. This is what `GCSA::locate`
+ *  reports for the ranges found by `GCSA::find` for patterns not longer than the
+ *  order of the index.
+ */
+class ReferenceMatcher
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef KmerGraph::node_type node_type;
+    /* ====================  LIFECYCLE     ======================================= */
+    ReferenceMatcher( const KmerGraph& g ) : graph( g ) { }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Locate all occurrences of a pattern.
+     *
+     *  @param  pattern The pattern.
+     *  @param  results The sorted start nodes of the occurrences.
+     */
+      inline void
+    locate( const std::string& pattern, std::vector< node_type >& results ) const
+    {
+      results.clear();
+      if ( pattern.empty() ) return;
+      for ( std::size_t i = 0; i < this->graph.size(); ++i ) {
+        if ( !results.empty() && results.back() == this->graph.from( i ) ) continue;
+        if ( this->match( pattern, 0, i ) ) results.push_back( this->graph.from( i ) );
+      }
+      std::sort( results.begin(), results.end() );
+      results.erase( std::unique( results.begin(), results.end() ), results.end() );
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    const KmerGraph& graph;
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Whether the suffix of `pattern` from `offset` is spelled by a walk
+     *          starting with k-mer `i`.
+     */
+      inline bool
+    match( const std::string& pattern, std::size_t offset, std::size_t i ) const
+    {
+      std::size_t k = this->graph.kmer_length();
+      std::size_t len = std::min( k, pattern.size() - offset );
+      if ( std::strncmp( this->graph.label( i ), pattern.data() + offset, len ) != 0 ) {
+        return false;
+      }
+      if ( offset + len == pattern.size() ) return true;
+      auto next = this->graph.kmers_from( this->graph.to( i ) );
+      for ( std::size_t j = next.first; j < next.second; ++j ) {
+        if ( this->match( pattern, offset + k, j ) ) return true;
+      }
+      return false;
+    }
+};  /* -----  end of class ReferenceMatcher  ----- */
+
+#endif  // REFERENCE_H__
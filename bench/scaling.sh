@@ -0,0 +1,131 @@
+#!/bin/sh
+#
+# Measure strong and weak thread scaling of gcsa_locate.
+#
+# Usage: scaling.sh -x GCSA_LOCATE -g GCSA -o OUTDIR -y GCSA_SIMULATE -f FASTA
+#                   [-t "THREADS..."] [-k K] [-n REPEAT] [-r READS]
+#                   [-w N:L:E:I] [-b PER_THREAD]
+#
+# Strong scaling runs every thread count over the same input: READS if given,
+# otherwise the workload simulated by `-w`. Weak scaling runs each thread count t
+# over a workload of t * PER_THREAD reads simulated with the length and error rates
+# of `-w`. Each point is the median of REPEAT runs. Speedup and efficiency of the
+# find and locate phases and of both together ("query") relative to one thread are
+# printed and written to OUTDIR/scaling.csv.
+
+usage() {
+  sed -n 's/^# \{0,1\}//; 3,15p' "$0" >&2
+  exit 1
+}
+
+. "$(dirname "$0")/common.sh"
+
+exe=
+gcsa=
+outdir=bench-results
+simulator=
+fasta=
+threads="1 2 4 8"
+k=16
+repeat=3
+reads=
+workload="100000:100:0.01:0.001"
+per_thread=25000
+
+while getopts "x:g:o:y:f:t:k:n:r:w:b:h" opt; do
+  case $opt in
+    x) exe=$OPTARG ;;
+    g) gcsa=$OPTARG ;;
+    o) outdir=$OPTARG ;;
+    y) simulator=$OPTARG ;;
+    f) fasta=$OPTARG ;;
+    t) threads=$OPTARG ;;
+    k) k=$OPTARG ;;
+    n) repeat=$OPTARG ;;
+    r) reads=$OPTARG ;;
+    w) workload=$OPTARG ;;
+    b) per_thread=$OPTARG ;;
+    *) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+
+[ -n "$exe" ] && [ -n "$gcsa" ] && [ -n "$simulator" ] && [ -n "$fasta" ] || usage
+case " $threads " in *" 1 "*) ;; *) threads="1 $threads" ;; esac
+
+mkdir -p "$outdir/scaling" || exit 1
+if [ -z "$reads" ]; then
+  reads=$(simulate_workload "$simulator" "$fasta" "$outdir/workloads" "$workload") ||
+    exit 1
+fi
+rest=${workload#*:}
+
+# Run REPEAT times and print the median find, locate and find+locate times.
+#
+# Usage: measure ID READS THREADS
+measure() {
+  finds=
+  locates=
+  queries=
+  rep=1
+  while [ "$rep" -le "$repeat" ]; do
+    stats="$outdir/scaling/$1.r$rep.json"
+    echo "scaling.sh: $1.r$rep" >&2
+    if ! "$exe" -g "$gcsa" -l "$k" -t "$3" -o /dev/null -S "$stats" "$2" \
+         > "$outdir/scaling/$1.r$rep.log" 2>&1; then
+      echo "scaling.sh: run $1.r$rep failed; see $outdir/scaling/$1.r$rep.log" >&2
+      return 1
+    fi
+    f=$(stat_value "$stats" phases find)
+    l=$(stat_value "$stats" phases locate)
+    finds="$finds $f"
+    locates="$locates $l"
+    queries="$queries $((f + l))"
+    rep=$((rep + 1))
+  done
+  echo "$(median $finds) $(median $locates) $(median $queries)"
+}
+
+csv="$outdir/scaling.csv"
+echo "mode,threads,reads,phase,median_us,speedup,efficiency" > "$csv"
+
+for mode in strong weak; do
+  base=
+  for t in $threads; do
+    if [ "$mode" = "strong" ]; then
+      input=$reads
+    else
+      input=$(simulate_workload "$simulator" "$fasta" "$outdir/workloads" \
+        "$((t * per_thread)):$rest") || exit 1
+    fi
+    times=$(measure "$mode.t$t" "$input" "$t") || exit 1
+    [ -n "$base" ] || base=$times
+    set -- $base
+    b_find=$1 b_locate=$2 b_query=$3
+    set -- $times
+    for phase in find locate query; do
+      case $phase in
+        find) cur=$1 ref=$b_find ;;
+        locate) cur=$2 ref=$b_locate ;;
+        query) cur=$3 ref=$b_query ;;
+      esac
+      # Strong: speedup = T1 / Tt, efficiency = speedup / t.
+      # Weak: efficiency = T1 / Tt, (scaled) speedup = t * efficiency.
+      awk -v m="$mode" -v t="$t" -v r="$(basename "$input" .seq)" -v p="$phase" \
+          -v c="$cur" -v b="$ref" 'BEGIN {
+        x = (c > 0) ? b / c : 0
+        if (m == "strong") { s = x; e = x / t } else { e = x; s = x * t }
+        printf "%s,%d,%s,%s,%s,%.3f,%.3f\n", m, t, r, p, c, s, e
+      }' >> "$csv"
+    done
+  done
+done
+
+awk -F, 'NR > 1 {
+  if ($1 != mode) {
+    mode = $1
+    printf "\n%s scaling\n%8s  %-8s %14s %9s %11s\n", mode, "threads", "phase",
+           "median_us", "speedup", "efficiency"
+  }
+  printf "%8d  %-8s %14s %9.2f %10.1f%%\n", $2, $4, $5, $6, $7 * 100
+}' "$csv"
@@ -0,0 +1,159 @@
+/**
+ *    @file  seed_bench.cc
+ *   @brief  Seeding micro-benchmarks.
+ *
+ *  Measures the throughput and the allocation cost of the seeding strategies.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  14:45
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+
+#include "harness.h"
+#include "seed.h"
+#include "kmer.h"
+
+
+constexpr std::size_t NOF_READS = 1000;    /**< @brief Number of reads per iteration. */
+
+/**
+ *  @brief  Generate a fixed set of random reads.
+ */
+template< typename TText >
+    inline std::vector< TText >
+  random_reads( std::size_t count, std::size_t len )
+  {
+    static const char bases[] = "ACGT";
+    std::mt19937_64 rng( len );
+    std::uniform_int_distribution< int > base( 0, 3 );
+    std::vector< TText > reads( count );
+    for ( auto& read : reads ) {
+      for ( std::size_t i = 0; i < len; ++i ) read.push_back( bases[ base( rng ) ] );
+    }
+    return reads;
+  }
+
+/**
+ *  @brief  Benchmark seeding a batch of reads with the given strategy.
+ *
+ *  @param  len The read length.
+ *  @param  k The seed length.
+ *  @param  spec The seeding strategy tag or the step size.
+ *  @param  reuse Whether the seed set is reused among iterations (warm) or is a new
+ *                container in each iteration (cold).
+ */
+template< typename TText, typename TSpec >
+    inline void
+  register_seeding( const std::string& repr, const std::string& strategy,
+      std::size_t len, unsigned int k, TSpec spec, bool reuse )
+  {
+    std::string name = "seeding/" + repr + "/" + strategy + "/len:" + std::to_string( len )
+      + "/k:" + std::to_string( k ) + ( reuse ? "/warm" : "/cold" );
+    bench::register_benchmark( name, [=]( bench::State& state ) {
+        state.pause_timing();
+        auto reads = random_reads< TText >( NOF_READS, len );
+        std::vector< TText > seeds;
+        state.resume_timing();
+        std::uint64_t total = 0;
+        while ( state.keep_running() ) {
+          if ( reuse ) {
+            seeds.clear();
+            seeding( seeds, reads, k, spec );
+          }
+          else {
+            std::vector< TText > fresh;
+            seeding( fresh, reads, k, spec );
+            total += fresh.size();
+            bench::do_not_optimize( fresh.data() );
+            continue;
+          }
+          total += seeds.size();
+          bench::do_not_optimize( seeds.data() );
+        }
+        state.set_items_processed( total );
+        });
+  }
+
+/**
+ *  @brief  Benchmark step seeding into packed k-mers (see `packed_seeding`).
+ *
+ *  Registers nothing if `k` is not a packed seed length.
+ */
+template< typename TText >
+    inline void
+  register_packed_seeding( const std::string& repr, std::size_t len, unsigned int k,
+      bool reuse )
+  {
+    std::string name = "seeding/" + repr + "/packed-step:" + std::to_string( k / 2 )
+      + "/len:" + std::to_string( len ) + "/k:" + std::to_string( k )
+      + ( reuse ? "/warm" : "/cold" );
+    dispatch_packed( k, [&]( auto kk ) {
+        constexpr unsigned int K = decltype( kk )::value;
+        bench::register_benchmark( name, [=]( bench::State& state ) {
+            state.pause_timing();
+            auto reads = random_reads< TText >( NOF_READS, len );
+            std::vector< std::uint64_t > seeds;
+            state.resume_timing();
+            std::uint64_t total = 0;
+            while ( state.keep_running() ) {
+              if ( reuse ) {
+                seeds.clear();
+                packed_seeding< K >( seeds, reads, K / 2 );
+              }
+              else {
+                std::vector< std::uint64_t > fresh;
+                packed_seeding< K >( fresh, reads, K / 2 );
+                total += fresh.size();
+                bench::do_not_optimize( fresh.data() );
+                continue;
+              }
+              total += seeds.size();
+              bench::do_not_optimize( seeds.data() );
+            }
+            state.set_items_processed( total );
+            } );
+        } );
+  }
+
+template< typename TText >
+    inline void
+  register_representation( const std::string& repr )
+  {
+    for ( std::size_t len : { 100, 150, 250, 1000 } ) {
+      for ( unsigned int k : { 12, 16, 20, 32 } ) {
+        for ( bool reuse : { true, false } ) {
+          register_seeding< TText >( repr, "greedy-overlapping", len, k,
+              GreedyOverlapping(), reuse );
+          register_seeding< TText >( repr, "non-overlapping", len, k,
+              NonOverlapping(), reuse );
+          register_seeding< TText >( repr, "greedy-non-overlapping", len, k,
+              GreedyNonOverlapping(), reuse );
+          register_seeding< TText >( repr, "step:" + std::to_string( k / 2 ), len, k,
+              k / 2, reuse );
+          register_seeding< TText >( repr, "minimizer:10", len, k, Minimizers( 10 ),
+              reuse );
+          register_seeding< TText >( repr, "closed-syncmer:8", len, k, Syncmers( 8 ),
+              reuse );
+          register_packed_seeding< TText >( repr, len, k, reuse );
+        }
+      }
+    }
+  }
+
+
+  int
+main( int argc, char* argv[] )
+{
+  register_representation< std::string >( "string" );
+  return bench::main( argc, argv );
+}
@@ -0,0 +1,182 @@
+/**
+ *    @file  simulate.cc
+ *   @brief  Read simulator program.
+ *
+ *  Simulates workloads for gcsa_locate from a FASTA file or a GCSA2 input graph.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  13:05
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+
+#include <omp.h>
+#include <seqan/arg_parse.h>
+
+#include <config.h>
+#include "simulator.h"
+#include "kmer_graph.h"
+#include "timer.h"
+#include "release.h"
+
+
+typedef struct {
+  std::string fasta_filename;
+  std::string graph_filename;
+  std::string output_filename;
+  unsigned int count;
+  unsigned int length;
+  double subst_rate;
+  double indel_rate;
+  unsigned int seed;
+  unsigned int threads;
+} SimOptions;
+
+constexpr std::size_t CHUNK_SIZE = 4096;    /**< @brief Number of reads per chunk. */
+
+
+  seqan::ArgumentParser::ParseResult
+parse_args( SimOptions& options, int argc, char* argv[] );
+
+template< typename TSource >
+    void
+  simulate( const TSource& source, const SimOptions& options );
+
+
+  int
+main( int argc, char* argv[] )
+{
+  SimOptions options;
+  auto res = parse_args( options, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK )
+    return res == seqan::ArgumentParser::PARSE_ERROR;
+
+  omp_set_num_threads( options.threads );
+  if ( options.output_filename.empty() ) {
+    options.output_filename = reads_filename( options.count, options.length,
+        options.subst_rate, options.indel_rate );
+  }
+
+  std::cerr << "Loading reference..." << std::endl;
+  if ( !options.graph_filename.empty() ) {
+    KmerGraph graph( options.graph_filename );
+    std::cerr << "Loaded " << graph.size() << " k-mers." << std::endl;
+    simulate( graph, options );
+  }
+  else {
+    FastaSource fasta( options.fasta_filename );
+    simulate( fasta, options );
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief  Simulate reads and write them to the output file.
+ *
+ *  Chunks of reads are simulated in parallel and written in order of their indices.
+ */
+template< typename TSource >
+    void
+  simulate( const TSource& source, const SimOptions& options )
+  {
+    std::ofstream ofs( options.output_filename, std::ofstream::out | std::ofstream::binary );
+    if ( !ofs ) {
+      throw std::runtime_error( "could not open file '" + options.output_filename + "'" );
+    }
+    ReadSimulator< TSource > sim( source, options.length, options.subst_rate,
+        options.indel_rate );
+    std::size_t nof_chunks = ( options.count + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+    std::vector< std::string > chunks( options.threads * 4 );
+
+    std::cerr << "Simulating " << options.count << " reads into '"
+              << options.output_filename << "'..." << std::endl;
+    {
+      auto timer = Timer< SteadyClock >( "simulate" );
+      for ( std::size_t first = 0; first < nof_chunks; first += chunks.size() ) {
+        std::size_t last = std::min( first + chunks.size(), nof_chunks );
+#pragma omp parallel for schedule( dynamic, 1 )
+        for ( std::size_t c = first; c < last; ++c ) {
+          std::size_t count = std::min< std::size_t >( CHUNK_SIZE,
+              options.count - c * CHUNK_SIZE );
+          simulate_chunk( chunks[ c - first ], sim, options.seed, c, count );
+        }
+        for ( std::size_t c = first; c < last; ++c ) ofs << chunks[ c - first ];
+      }
+    }
+    std::cerr << "Simulated " << options.count << " reads in "
+              << Timer< SteadyClock >::get_duration_str( "simulate" ) << "." << std::endl;
+  }
+
+
+  inline seqan::ArgumentParser::ParseResult
+parse_args( SimOptions& options, int argc, char* argv[] )
+{
+  seqan::ArgumentParser parser( "gcsa_simulate" );
+  addUsageLine( parser, "[\\fIOPTIONS\\fP] \\fB-f\\fP \\fIFASTA\\fP" );
+  addUsageLine( parser, "[\\fIOPTIONS\\fP] \\fB-g\\fP \\fIGRAPH\\fP" );
+  setShortDescription( parser, "Read simulator" );
+  setVersion( parser, release::version );
+  setDate( parser, LAST_MOD_DATE );
+  addDescription( parser, "Simulate reads from a reference sequence or by random "
+      "walks in the GCSA2 input graph. The output only depends on the random seed "
+      "and not on the number of threads." );
+  addOption( parser, seqan::ArgParseOption( "f", "fasta", "Reference FASTA file.",
+        seqan::ArgParseArgument::INPUT_FILE, "FASTA" ) );
+  addOption( parser, seqan::ArgParseOption( "g", "graph", "GCSA2 input graph file.",
+        seqan::ArgParseArgument::INPUT_FILE, "GRAPH" ) );
+  addOption( parser, seqan::ArgParseOption( "n", "count", "Number of reads.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setRequired( parser, "n" );
+  addOption( parser, seqan::ArgParseOption( "l", "length", "Read length.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setRequired( parser, "l" );
+  addOption( parser, seqan::ArgParseOption( "e", "subst-rate",
+        "Substitution rate per base.", seqan::ArgParseArgument::DOUBLE, "FLOAT" ) );
+  setDefaultValue( parser, "e", 0 );
+  addOption( parser, seqan::ArgParseOption( "i", "indel-rate",
+        "Indel rate per base.", seqan::ArgParseArgument::DOUBLE, "FLOAT" ) );
+  setDefaultValue( parser, "i", 0 );
+  addOption( parser, seqan::ArgParseOption( "s", "seed", "Random seed.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "s", 0 );
+  addOption( parser, seqan::ArgParseOption( "t", "threads", "Number of threads.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "t", "1" );
+  setDefaultValue( parser, "t", 1 );
+  addOption( parser, seqan::ArgParseOption( "o", "output",
+        "Output file [default: reads_n<N>l<L>e<E>i<I>.seq].",
+        seqan::ArgParseArgument::OUTPUT_FILE, "OUTPUT" ) );
+
+  auto res = seqan::parse( parser, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK ) return res;
+
+  getOptionValue( options.fasta_filename, parser, "fasta" );
+  getOptionValue( options.graph_filename, parser, "graph" );
+  getOptionValue( options.output_filename, parser, "output" );
+  getOptionValue( options.count, parser, "count" );
+  getOptionValue( options.length, parser, "length" );
+  getOptionValue( options.subst_rate, parser, "subst-rate" );
+  getOptionValue( options.indel_rate, parser, "indel-rate" );
+  getOptionValue( options.seed, parser, "seed" );
+  getOptionValue( options.threads, parser, "threads" );
+  if ( options.fasta_filename.empty() == options.graph_filename.empty() ) {
+    std::cerr << "gcsa_simulate: exactly one of '-f' or '-g' should be given."
+              << std::endl;
+    return seqan::ArgumentParser::PARSE_ERROR;
+  }
+  return seqan::ArgumentParser::PARSE_OK;
+}
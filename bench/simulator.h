@@ -0,0 +1,232 @@
+/**
+ *    @file  simulator.h
+ *   @brief  Read simulator.
+ *
+ *  Simulates reads with substitution and indel errors from a reference source.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  12:10
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef SIMULATOR_H__
+#define SIMULATOR_H__
+
+#include <cstdio>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+
+/**
+ *  @brief  Reference source backed by the sequences of a FASTA file.
+ *
+ *  Fragments are sampled uniformly over all positions of all sequences.
+ */
+class FastaSource
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    FastaSource( const std::string& filename )
+    {
+      std::ifstream ifs( filename, std::ifstream::in );
+      if ( !ifs ) {
+        throw std::runtime_error( "could not open file '" + filename + "'" );
+      }
+      std::string line;
+      while ( std::getline( ifs, line ) ) {
+        if ( !line.empty() && line.back() == '\r' ) line.pop_back();
+        if ( line.empty() ) continue;
+        if ( line[0] == '>' ) {
+          this->sequences.emplace_back();
+          continue;
+        }
+        if ( this->sequences.empty() ) this->sequences.emplace_back();
+        for ( auto& c : line ) c = std::toupper( c );
+        this->sequences.back() += line;
+      }
+      std::size_t total = 0;
+      for ( const auto& seq : this->sequences ) {
+        total += seq.size();
+        this->cumulative.push_back( total );
+      }
+    }  /* -----  end of method FastaSource  (constructor)  ----- */
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Sample a fragment of length `len` from the reference.
+     *
+     *  @param  rng The random number generator.
+     *  @param  len The length of the fragment.
+     *  @param  fragment The sampled fragment.
+     *  @return `true` if a fragment without 'N' is sampled.
+     */
+      inline bool
+    sample( std::mt19937_64& rng, std::size_t len, std::string& fragment ) const
+    {
+      if ( this->cumulative.empty() || this->cumulative.back() == 0 ) return false;
+      std::uniform_int_distribution< std::size_t > dist( 0, this->cumulative.back() - 1 );
+      std::size_t pos = dist( rng );
+      auto it = std::upper_bound( this->cumulative.begin(), this->cumulative.end(), pos );
+      std::size_t idx = it - this->cumulative.begin();
+      pos -= ( idx == 0 ? 0 : this->cumulative[ idx - 1 ] );
+      const std::string& seq = this->sequences[ idx ];
+      if ( pos + len > seq.size() ) return false;
+      fragment.assign( seq, pos, len );
+      return fragment.find_first_not_of( "ACGT" ) == std::string::npos;
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    std::vector< std::string > sequences;
+    std::vector< std::size_t > cumulative;
+};  /* -----  end of class FastaSource  ----- */
+
+/**
+ *  @brief  Read simulator.
+ *
+ *  Generates reads of fixed length from either strand of fragments sampled from a
+ *  source by applying substitutions with rate `subst_rate` and insertions or
+ *  deletions with rate `indel_rate` per base.
+ *
+ *  The source should provide a method
+ *
+ *      bool sample( std::mt19937_64& rng, std::size_t len, std::string& fragment ) const;
+ *
+ *  returning a fragment of length `len` containing only 'A', 'C', 'G' and 'T'.
+ */
+template< typename TSource >
+  class ReadSimulator
+  {
+    public:
+      /* ====================  CONSTANTS     ======================================= */
+      constexpr static const unsigned int MAX_ATTEMPTS = 1000;
+      /* ====================  LIFECYCLE     ======================================= */
+      ReadSimulator( const TSource& s, std::size_t len, double subst, double indel )
+        : source( s ), read_len( len ), subst_rate( subst ), indel_rate( indel )
+      { }
+      /* ====================  METHODS       ======================================= */
+      /**
+       *  @brief  Simulate one read.
+       *
+       *  @param  rng The random number generator.
+       *  @param  read The simulated read.
+       */
+        inline void
+      simulate( std::mt19937_64& rng, std::string& read ) const
+      {
+        static const char bases[] = "ACGT";
+        std::bernoulli_distribution subst( this->subst_rate );
+        std::bernoulli_distribution indel( this->indel_rate );
+        std::bernoulli_distribution coin( 0.5 );
+        std::uniform_int_distribution< int > other( 1, 3 );
+        std::uniform_int_distribution< int > base( 0, 3 );
+
+        /* Deletions consume more reference than the read length. */
+        std::size_t frag_len = this->read_len + this->read_len * this->indel_rate * 4 + 8;
+        unsigned int attempts = 0;
+        while ( !this->source.sample( rng, frag_len, this->fragment ) ) {
+          if ( ++attempts == MAX_ATTEMPTS ) {
+            throw std::runtime_error( "cannot sample fragments of length "
+                + std::to_string( frag_len ) + " from the source" );
+          }
+        }
+        if ( coin( rng ) ) reverse_complement( this->fragment );
+
+        read.clear();
+        for ( std::size_t i = 0; read.size() < this->read_len; ) {
+          if ( i == this->fragment.size() ) i = 0;  /* very unlikely */
+          if ( this->indel_rate > 0 && indel( rng ) ) {
+            if ( coin( rng ) ) read += bases[ base( rng ) ];  /* insertion */
+            else ++i;                                          /* deletion */
+            continue;
+          }
+          char c = this->fragment[ i++ ];
+          if ( this->subst_rate > 0 && subst( rng ) ) {
+            c = bases[ ( code( c ) + other( rng ) ) % 4 ];
+          }
+          read += c;
+        }
+      }
+
+        static inline void
+      reverse_complement( std::string& seq )
+      {
+        std::reverse( seq.begin(), seq.end() );
+        for ( auto& c : seq ) c = "TGCA"[ code( c ) ];
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      const TSource& source;
+      std::size_t read_len;
+      double subst_rate;
+      double indel_rate;
+      static thread_local std::string fragment;
+      /* ====================  METHODS       ======================================= */
+        static inline int
+      code( char c )
+      {
+        switch ( c ) {
+          case 'A': return 0;
+          case 'C': return 1;
+          case 'G': return 2;
+          default: return 3;
+        }
+      }
+  };  /* -----  end of template class ReadSimulator  ----- */
+
+template< typename TSource >
+  thread_local std::string ReadSimulator< TSource >::fragment;
+
+/**
+ *  @brief  Simulate a chunk of reads deterministically.
+ *
+ *  @param  chunk The output buffer; reads are appended one per line.
+ *  @param  sim The read simulator.
+ *  @param  seed The global seed.
+ *  @param  chunk_idx The index of the chunk.
+ *  @param  count The number of reads in the chunk.
+ *
+ *  The random number generator is seeded by both the global seed and the chunk
+ *  index, so the output only depends on the seed and not on the number of threads.
+ */
+template< typename TSource >
+    inline void
+  simulate_chunk( std::string& chunk, const ReadSimulator< TSource >& sim,
+      std::uint64_t seed, std::uint64_t chunk_idx, std::size_t count )
+  {
+    std::seed_seq sseq{ seed, chunk_idx };
+    std::mt19937_64 rng( sseq );
+    std::string read;
+    chunk.clear();
+    for ( std::size_t i = 0; i < count; ++i ) {
+      sim.simulate( rng, read );
+      chunk += read;
+      chunk += '\n';
+    }
+  }  /* -----  end of template function simulate_chunk  ----- */
+
+/**
+ *  @brief  Reads file name according to the naming scheme of the test data.
+ *
+ *  @return the file name `reads_n<N>l<L>e<E>i<I>.seq`; e.g. `reads_n100l100e0i0.seq`.
+ */
+  inline std::string
+reads_filename( std::size_t count, std::size_t len, double subst, double indel )
+{
+  char buf[ 128 ];
+  std::snprintf( buf, sizeof( buf ), "reads_n%zul%zue%gi%g.seq", count, len, subst,
+      indel );
+  return buf;
+}
+
+#endif  // SIMULATOR_H__
@@ -0,0 +1,394 @@
+/**
+ *    @file  verify.cc
+ *   @brief  Differential testing of the query engines.
+ *
+ *  Compares the occurrences reported by each query engine to the brute-force
+ *  reference matcher.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  18:50
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
+
+#include <omp.h>
+#include <seqan/arg_parse.h>
+#include <gcsa/gcsa.h>
+
+#include <config.h>
+#include "locator.h"
+#include "gcsalocate.h"
+#include "coalescer.h"
+#include "seed.h"
+#include "kmer.h"
+#include "simulator.h"
+#include "kmer_graph.h"
+#include "reference.h"
+#include "release.h"
+
+
+typedef struct {
+  std::string gcsa_filename;
+  std::string graph_filename;
+  std::string reads_filename;
+  std::string kvalues;
+  unsigned int count;
+  unsigned int length;
+  unsigned int seed;
+  unsigned int max_report;
+} VerifyOptions;
+
+typedef std::vector< std::vector< gcsa::node_type > > hits_type;
+
+/**
+ *  @brief  A query engine under test.
+ *
+ *  The engine reports the occurrences of each pattern; the order of occurrences
+ *  does not matter.
+ */
+struct Engine {
+  std::string name;
+  std::function< void( const std::vector< std::string >&, hits_type& ) > run;
+};
+
+
+  seqan::ArgumentParser::ParseResult
+parse_args( VerifyOptions& options, int argc, char* argv[] );
+
+
+/**
+ *  @brief  The engines to be verified.
+ */
+  inline std::vector< Engine >
+engines( const Locator& locator, const gcsalocate_t* handle )
+{
+  const gcsa::GCSA& index = locator.get_index();
+  std::vector< Engine > list;
+  list.push_back( { "find-locate",
+      [&index]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        hits.assign( patterns.size(), { } );
+        for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+          auto range = index.find( patterns[ i ] );
+          if ( !gcsa::Range::empty( range ) ) index.locate( range, hits[ i ] );
+        }
+      } } );
+  list.push_back( { "find-locate-omp",
+      [&index]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        hits.assign( patterns.size(), { } );
+#pragma omp parallel for schedule( dynamic, 64 )
+        for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+          auto range = index.find( patterns[ i ] );
+          if ( !gcsa::Range::empty( range ) ) index.locate( range, hits[ i ] );
+        }
+      } } );
+  list.push_back( { "locator-batch",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        std::vector< Locator::range_type > ranges;
+        locator.find( patterns, ranges );
+        std::vector< std::size_t > found;
+        std::vector< Locator::range_type > nonempty;
+        for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+          if ( gcsa::Range::empty( ranges[ i ] ) ) continue;
+          found.push_back( i );
+          nonempty.push_back( ranges[ i ] );
+        }
+        hits_type results;
+        locator.locate( nonempty, results );
+        hits.assign( patterns.size(), { } );
+        for ( std::size_t i = 0; i < found.size(); ++i ) {
+          hits[ found[ i ] ].swap( results[ i ] );
+        }
+      } } );
+  list.push_back( { "locator-packed",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        hits.assign( patterns.size(), { } );
+        if ( patterns.empty() ) return;
+        std::vector< Locator::range_type > expected;
+        locator.find( patterns, expected );
+        std::vector< Locator::range_type > ranges;
+        std::vector< std::uint64_t > kmers;
+        bool packed = dispatch_packed( patterns.front().size(), [&]( auto k ) {
+            pack< decltype( k )::value >( kmers, patterns );
+            locator.find< decltype( k )::value >( kmers, ranges );
+            } );
+        /* Lengths without a packed engine are searched as strings. */
+        if ( !packed ) ranges = expected;
+        for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+          if ( !gcsa::Range::empty( ranges[ i ] ) ) locator.locate( ranges[ i ], hits[ i ] );
+          /* A range differing from the one of the string search is reported as a
+           * mismatch even if it locates the same occurrences. */
+          if ( ranges[ i ] != expected[ i ] ) hits[ i ].push_back( ~gcsa::node_type( 0 ) );
+        }
+      } } );
+  list.push_back( { "locator-hits",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        Hits batch;
+        locator.locate( patterns.begin(), patterns.end(), batch );
+        hits.assign( patterns.size(), { } );
+        for ( std::size_t i = 0; i < batch.size(); ++i ) {
+          hits[ i ].assign( batch.begin( i ), batch.end( i ) );
+        }
+      } } );
+  list.push_back( { "locator-visit",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        hits.assign( patterns.size(), { } );
+        locator.visit( patterns.begin(), patterns.end(),
+            [&hits]( Locator::size_type i, Locator::node_type node ) {
+              hits[ i ].push_back( node );
+            } );
+      } } );
+  list.push_back( { "locator-chunks",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        hits.assign( patterns.size(), { } );
+        Locator::nodes_type chunk;
+        for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+          /* A small chunk size such that most ranges are split. */
+          LocateCursor cursor( locator, locator.find( patterns[ i ] ), 3 );
+          while ( cursor.next( chunk ) ) {
+            hits[ i ].insert( hits[ i ].end(), chunk.begin(), chunk.end() );
+          }
+        }
+      } } );
+  list.push_back( { "coalescer",
+      [&locator]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        /* Small requests submitted at once such that they are coalesced. */
+        const std::size_t request_size = 7;
+        Coalescer coalescer( locator );
+        std::vector< std::future< Hits > > futures;
+        for ( std::size_t i = 0; i < patterns.size(); i += request_size ) {
+          auto last = std::min( i + request_size, patterns.size() );
+          futures.push_back( coalescer.submit( std::vector< std::string >(
+                  patterns.begin() + i, patterns.begin() + last ) ) );
+        }
+        hits.assign( patterns.size(), { } );
+        std::size_t i = 0;
+        for ( auto& future : futures ) {
+          Hits batch = future.get();
+          for ( std::size_t j = 0; j < batch.size(); ++j, ++i ) {
+            hits[ i ].assign( batch.begin( j ), batch.end( j ) );
+          }
+        }
+      } } );
+  list.push_back( { "c-abi",
+      [handle]( const std::vector< std::string >& patterns, hits_type& hits ) {
+        std::string text;
+        std::vector< uint64_t > offsets( 1, 0 );
+        for ( const auto& pattern : patterns ) {
+          text += pattern;
+          offsets.push_back( text.size() );
+        }
+        std::size_t n = patterns.size();
+        std::vector< gcsalocate_range_t > ranges( n );
+        std::vector< uint64_t > counts( n );
+        auto check = []( gcsalocate_status status ) {
+          if ( status != GCSALOCATE_OK ) throw std::runtime_error( gcsalocate_last_error() );
+        };
+        check( gcsalocate_find( handle, text.data(), offsets.data(), n, ranges.data() ) );
+        check( gcsalocate_count( handle, ranges.data(), n, counts.data() ) );
+        uint64_t total = 0;
+        for ( auto c : counts ) total += c;
+        std::vector< gcsalocate_node_t > nodes( total );
+        std::vector< uint64_t > node_offsets( n + 1 );
+        check( gcsalocate_locate( handle, ranges.data(), n, nodes.data(), nodes.size(),
+              node_offsets.data(), &total ) );
+        hits.assign( n, { } );
+        for ( std::size_t i = 0; i < n; ++i ) {
+          hits[ i ].assign( nodes.begin() + node_offsets[ i ],
+              nodes.begin() + node_offsets[ i + 1 ] );
+        }
+      } } );
+  return list;
+}
+
+/**
+ *  @brief  Verify all engines on the k-mers of the given reads.
+ *
+ *  @return the number of mismatching patterns over all engines.
+ */
+  inline std::size_t
+verify( const std::string& input, const std::vector< std::string >& reads,
+    unsigned int k, const ReferenceMatcher& reference,
+    const std::vector< Engine >& list, unsigned int max_report )
+{
+  std::vector< std::string > patterns;
+  seeding( patterns, reads, k, GreedyOverlapping() );
+  std::sort( patterns.begin(), patterns.end() );
+  patterns.erase( std::unique( patterns.begin(), patterns.end() ), patterns.end() );
+
+  hits_type expected( patterns.size() );
+  std::size_t total = 0;
+#pragma omp parallel for schedule( dynamic, 16 ) reduction( +:total )
+  for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+    reference.locate( patterns[ i ], expected[ i ] );
+    total += expected[ i ].size();
+  }
+  std::cout << input << " k=" << k << ": " << patterns.size() << " patterns, "
+            << total << " occurrences" << std::endl;
+
+  std::size_t failures = 0;
+  hits_type hits;
+  for ( const auto& engine : list ) {
+    engine.run( patterns, hits );
+    std::size_t mismatches = 0;
+    for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+      std::sort( hits[ i ].begin(), hits[ i ].end() );
+      hits[ i ].erase( std::unique( hits[ i ].begin(), hits[ i ].end() ), hits[ i ].end() );
+      if ( hits[ i ] == expected[ i ] ) continue;
+      if ( mismatches++ < max_report ) {
+        std::cout << "  " << engine.name << ": " << patterns[ i ] << ": expected "
+                  << expected[ i ].size() << " occurrences, got " << hits[ i ].size()
+                  << std::endl;
+      }
+    }
+    std::cout << "  " << engine.name << ": "
+              << ( mismatches == 0 ? "ok" : std::to_string( mismatches ) + " mismatches" )
+              << std::endl;
+    failures += mismatches;
+  }
+  return failures;
+}
+
+
+  int
+main( int argc, char* argv[] )
+{
+  VerifyOptions options;
+  auto res = parse_args( options, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK )
+    return res == seqan::ArgumentParser::PARSE_ERROR;
+
+  Locator locator( options.gcsa_filename );
+  gcsalocate_t* handle;
+  if ( gcsalocate_load( options.gcsa_filename.c_str(), &handle ) != GCSALOCATE_OK ) {
+    throw std::runtime_error( gcsalocate_last_error() );
+  }
+  KmerGraph graph( options.graph_filename );
+  ReferenceMatcher reference( graph );
+  auto list = engines( locator, handle );
+
+  /* Inputs: uniformly random reads, reads simulated from the graph, and the reads file. */
+  std::vector< std::pair< std::string, std::vector< std::string > > > inputs;
+  {
+    std::mt19937_64 rng( options.seed );
+    std::uniform_int_distribution< int > base( 0, 3 );
+    std::vector< std::string > reads( options.count );
+    for ( auto& read : reads ) {
+      for ( unsigned int i = 0; i < options.length; ++i ) read += "ACGT"[ base( rng ) ];
+    }
+    inputs.emplace_back( "random", std::move( reads ) );
+  }
+  {
+    ReadSimulator< KmerGraph > sim( graph, options.length, 0.01, 0.001 );
+    std::string chunk;
+    simulate_chunk( chunk, sim, options.seed, 0, options.count );
+    std::vector< std::string > reads;
+    std::size_t pos = 0;
+    for ( std::size_t end; ( end = chunk.find( '\n', pos ) ) != std::string::npos; pos = end + 1 ) {
+      reads.push_back( chunk.substr( pos, end - pos ) );
+    }
+    inputs.emplace_back( "simulated", std::move( reads ) );
+  }
+  if ( !options.reads_filename.empty() ) {
+    std::ifstream ifs( options.reads_filename, std::ifstream::in );
+    if ( !ifs ) {
+      throw std::runtime_error( "could not open file '" + options.reads_filename + "'" );
+    }
+    std::vector< std::string > reads;
+    std::string line;
+    while ( std::getline( ifs, line ) ) reads.push_back( line );
+    inputs.emplace_back( options.reads_filename, std::move( reads ) );
+  }
+
+  std::size_t failures = 0;
+  std::size_t pos = 0;
+  while ( pos < options.kvalues.size() ) {
+    std::size_t end = std::min( options.kvalues.find( ',', pos ), options.kvalues.size() );
+    unsigned int k = std::stoul( options.kvalues.substr( pos, end - pos ) );
+    pos = end + 1;
+    if ( k > locator.order() ) {
+      std::cout << "k=" << k << " is larger than the order of the index; skipped."
+                << std::endl;
+      continue;
+    }
+    for ( const auto& input : inputs ) {
+      failures += verify( input.first, input.second, k, reference, list,
+          options.max_report );
+    }
+  }
+
+  gcsalocate_free( handle );
+  std::cout << ( failures == 0 ? "All engines agree with the reference."
+      : "Engines disagree with the reference." ) << std::endl;
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+  inline seqan::ArgumentParser::ParseResult
+parse_args( VerifyOptions& options, int argc, char* argv[] )
+{
+  seqan::ArgumentParser parser( "gcsa_verify" );
+  addUsageLine( parser, "[\\fIOPTIONS\\fP] \\fB-g\\fP \\fIGCSA2_FILE\\fP "
+      "\\fB-G\\fP \\fIGRAPH\\fP" );
+  setShortDescription( parser, "Differential testing of query engines" );
+  setVersion( parser, release::version );
+  setDate( parser, LAST_MOD_DATE );
+  addDescription( parser, "Compare the occurrences of the k-mers of random, simulated "
+      "and given reads reported by each query engine to those found by brute-force "
+      "matching against the GCSA2 input graph." );
+  seqan::ArgParseOption gcsa_arg( "g", "gcsa", "GCSA2 index file.",
+      seqan::ArgParseArgument::INPUT_FILE, "GCSA2_FILE" );
+  setValidValues( gcsa_arg, gcsa::GCSA::EXTENSION );
+  addOption( parser, gcsa_arg );
+  setRequired( parser, "g" );
+  addOption( parser, seqan::ArgParseOption( "G", "graph",
+        "GCSA2 input graph from which the index is built.",
+        seqan::ArgParseArgument::INPUT_FILE, "GRAPH" ) );
+  setRequired( parser, "G" );
+  addOption( parser, seqan::ArgParseOption( "r", "reads", "Additional reads file.",
+        seqan::ArgParseArgument::INPUT_FILE, "READS" ) );
+  addOption( parser, seqan::ArgParseOption( "k", "seed-lens",
+        "Comma-separated seed lengths.", seqan::ArgParseArgument::STRING, "K1,K2,..." ) );
+  setDefaultValue( parser, "k", "8,12,16,20,32" );
+  addOption( parser, seqan::ArgParseOption( "n", "count",
+        "Number of random and of simulated reads.", seqan::ArgParseArgument::INTEGER,
+        "INT" ) );
+  setDefaultValue( parser, "n", 200 );
+  addOption( parser, seqan::ArgParseOption( "l", "length",
+        "Length of random and simulated reads.", seqan::ArgParseArgument::INTEGER,
+        "INT" ) );
+  setDefaultValue( parser, "l", 100 );
+  addOption( parser, seqan::ArgParseOption( "s", "seed", "Random seed.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "s", 0 );
+  addOption( parser, seqan::ArgParseOption( "m", "max-report",
+        "Maximum number of reported mismatches per engine and input.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "m", 10 );
+
+  auto res = seqan::parse( parser, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK ) return res;
+
+  getOptionValue( options.gcsa_filename, parser, "gcsa" );
+  getOptionValue( options.graph_filename, parser, "graph" );
+  getOptionValue( options.reads_filename, parser, "reads" );
+  getOptionValue( options.kvalues, parser, "seed-lens" );
+  getOptionValue( options.count, parser, "count" );
+  getOptionValue( options.length, parser, "length" );
+  getOptionValue( options.seed, parser, "seed" );
+  getOptionValue( options.max_report, parser, "max-report" );
+  return seqan::ArgumentParser::PARSE_OK;
+}
@@ -0,0 +1,98 @@
+/**
+ *    @file  checkpoint.h
+ *   @brief  Checkpoints of locate runs.
+ *
+ *  Records the progress of a run so that an interrupted run can be resumed.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  14:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef CHECKPOINT_H__
+#define CHECKPOINT_H__
+
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+
+/**
+ *  @brief  Progress of a locate run.
+ *
+ *  The found patterns of the indexes before `index` are located and written, and
+ *  so are the first `done` found patterns of index `index`, whose output is
+ *  `offset` bytes long. `index` equal to the number of indexes marks a finished
+ *  run. `run` describes the options which determine the patterns and the output, so
+ *  that a run is not resumed with different ones.
+ */
+struct Checkpoint {
+  std::string run;
+  std::uint64_t index = 0;
+  std::uint64_t done = 0;
+  std::uint64_t offset = 0;
+  std::uint64_t occurrences = 0;
+
+  /** @brief Suffix of the checkpoint file of an output. */
+  constexpr static const char* SUFFIX = ".ckpt";
+
+  /**
+   *  @brief  Read the checkpoint of an output.
+   *
+   *  @return false if there is no checkpoint.
+   */
+    inline bool
+  load( const std::string& output_filename )
+  {
+    std::string filename = output_filename + SUFFIX;
+    std::ifstream ifs( filename, std::ifstream::in );
+    if ( !ifs ) return false;
+    std::string key;
+    if ( !( ifs >> key ) || key != "run" || !std::getline( ifs >> std::ws, this->run )
+        || !( ifs >> key >> this->index ) || key != "index"
+        || !( ifs >> key >> this->done ) || key != "done"
+        || !( ifs >> key >> this->offset ) || key != "offset"
+        || !( ifs >> key >> this->occurrences ) || key != "occurrences" ) {
+      throw std::runtime_error( "malformed checkpoint file '" + filename + "'" );
+    }
+    return true;
+  }
+
+  /**
+   *  @brief  Write the checkpoint of an output.
+   *
+   *  The checkpoint is written to a temporary file which then replaces the previous
+   *  one, so that a valid checkpoint exists at any time.
+   */
+    inline void
+  save( const std::string& output_filename ) const
+  {
+    std::string filename = output_filename + SUFFIX;
+    std::string tmp_filename = filename + ".tmp";
+    {
+      std::ofstream ofs( tmp_filename, std::ofstream::out );
+      ofs << "run " << this->run << std::endl
+          << "index " << this->index << std::endl
+          << "done " << this->done << std::endl
+          << "offset " << this->offset << std::endl
+          << "occurrences " << this->occurrences << std::endl;
+      if ( !ofs ) {
+        throw std::runtime_error( "could not write file '" + tmp_filename + "'" );
+      }
+    }
+    if ( std::rename( tmp_filename.c_str(), filename.c_str() ) != 0 ) {
+      throw std::runtime_error( "could not rename '" + tmp_filename + "' to '"
+          + filename + "'" );
+    }
+  }
+};
+
+#endif  // CHECKPOINT_H__
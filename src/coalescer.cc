@@ -0,0 +1,133 @@
+/**
+ *    @file  coalescer.cc
+ *   @brief  Request coalescer implementation.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  10:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <exception>
+#include <iterator>
+
+#include "coalescer.h"
+
+
+Coalescer::Coalescer( const Locator& l, std::size_t bsize, duration_type w )
+  : locator( l ), batch_size( bsize ), window( w ), pending_seeds( 0 ),
+  stopping( false ), nof_batches( 0 ), nof_requests( 0 )
+{
+  this->worker = std::thread( &Coalescer::run, this );
+}
+
+
+Coalescer::~Coalescer( )
+{
+  {
+    std::lock_guard< std::mutex > lock( this->mutex );
+    this->stopping = true;
+  }
+  this->cv.notify_one();
+  this->worker.join();
+}
+
+
+  std::future< Hits >
+Coalescer::submit( std::vector< std::string > seeds )
+{
+  Request request;
+  request.seeds = std::move( seeds );
+  std::future< Hits > future = request.promise.get_future();
+  bool notify;
+  {
+    std::lock_guard< std::mutex > lock( this->mutex );
+    if ( this->pending.empty() ) this->pending_since = clock_type::now();
+    this->pending_seeds += request.seeds.size();
+    this->pending.push_back( std::move( request ) );
+    notify = this->pending.size() == 1 || this->pending_seeds >= this->batch_size;
+  }
+  if ( notify ) this->cv.notify_one();
+  return future;
+}
+
+
+  void
+Coalescer::run( )
+{
+  std::vector< Request > requests;
+  std::unique_lock< std::mutex > lock( this->mutex );
+  while ( true ) {
+    this->cv.wait( lock, [this]( ) { return this->stopping || !this->pending.empty(); } );
+    if ( this->pending.empty() ) break;
+    this->cv.wait_until( lock, this->pending_since + this->window, [this]( ) {
+        return this->stopping || this->pending_seeds >= this->batch_size;
+        } );
+    requests.swap( this->pending );
+    this->pending_seeds = 0;
+    lock.unlock();
+    this->process( requests );
+    requests.clear();
+    lock.lock();
+  }
+}
+
+
+  void
+Coalescer::process( std::vector< Request >& requests )
+{
+  ++this->nof_batches;
+  this->nof_requests += requests.size();
+  try {
+    std::vector< std::string > patterns;
+    for ( auto& request : requests ) {
+      std::move( request.seeds.begin(), request.seeds.end(),
+          std::back_inserter( patterns ) );
+    }
+    std::vector< Locator::range_type > ranges;
+    this->locator.find( patterns, ranges );
+    std::vector< std::size_t > found;
+    std::vector< Locator::range_type > found_ranges;
+    for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+      if ( gcsa::Range::empty( ranges[ i ] ) ) continue;
+      found.push_back( i );
+      found_ranges.push_back( ranges[ i ] );
+    }
+    std::vector< Locator::nodes_type > results;
+    this->locator.locate( found_ranges, results );
+
+    /* Scatter the results back to the requests. */
+    std::size_t first = 0;
+    std::size_t next_found = 0;
+    for ( auto& request : requests ) {
+      std::size_t last = first + request.seeds.size();
+      Hits hits;
+      hits.offsets.push_back( 0 );
+      for ( std::size_t i = first; i < last; ++i ) {
+        hits.ranges.push_back( ranges[ i ] );
+        if ( next_found < found.size() && found[ next_found ] == i ) {
+          const auto& nodes = results[ next_found++ ];
+          hits.nodes.insert( hits.nodes.end(), nodes.begin(), nodes.end() );
+        }
+        hits.offsets.push_back( hits.nodes.size() );
+      }
+      request.promise.set_value( std::move( hits ) );
+      first = last;
+    }
+  }
+  catch ( ... ) {
+    for ( auto& request : requests ) {
+      try {
+        request.promise.set_exception( std::current_exception() );
+      }
+      catch ( const std::future_error& ) {
+        /* The promise is already satisfied. */
+      }
+    }
+  }
+}
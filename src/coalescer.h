@@ -0,0 +1,113 @@
+/**
+ *    @file  coalescer.h
+ *   @brief  Request coalescer.
+ *
+ *  Batches small locate requests of concurrent clients into larger queries.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  10:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef COALESCER_H__
+#define COALESCER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "locator.h"
+
+
+/**
+ *  @brief  Request coalescer.
+ *
+ *  Collects the seeds of requests submitted concurrently by clients until either
+ *  `batch_size` seeds are pending or `window` has passed since the first pending
+ *  request, then runs one batched (OpenMP-parallel) find and locate for all of them
+ *  in a background thread and scatters the occurrences back to the requests. A
+ *  longer window gives larger batches and higher throughput at the cost of latency.
+ *
+ *  Pending requests are processed before the destructor returns. The locator must
+ *  outlive the coalescer.
+ */
+class Coalescer
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef std::chrono::steady_clock clock_type;
+    typedef std::chrono::microseconds duration_type;
+    /* ====================  LIFECYCLE     ======================================= */
+    Coalescer( const Locator& locator, std::size_t batch_size=4096,
+        duration_type window=duration_type( 200 ) );
+    ~Coalescer( );
+
+    Coalescer( const Coalescer& ) = delete;
+    Coalescer& operator=( const Coalescer& ) = delete;
+    /* ====================  ACCESSORS     ======================================= */
+    /**
+     *  @brief  Number of batches run so far.
+     */
+      inline std::size_t
+    get_batches( ) const
+    {
+      return this->nof_batches;
+    }
+
+    /**
+     *  @brief  Number of requests completed so far.
+     */
+      inline std::size_t
+    get_requests( ) const
+    {
+      return this->nof_requests;
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Submit a request; thread-safe.
+     *
+     *  @param  seeds The seeds to be located.
+     *  @return the future of the ranges and occurrences of the seeds, in the same
+     *          order (see `Hits`).
+     */
+      std::future< Hits >
+    submit( std::vector< std::string > seeds );
+  private:
+    /* ====================  MEMBER TYPES  ======================================= */
+    struct Request {
+      std::vector< std::string > seeds;
+      std::promise< Hits > promise;
+    };
+    /* ====================  DATA MEMBERS  ======================================= */
+    const Locator& locator;
+    std::size_t batch_size;
+    duration_type window;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector< Request > pending;
+    std::size_t pending_seeds;
+    clock_type::time_point pending_since;
+    bool stopping;
+    std::atomic< std::size_t > nof_batches;
+    std::atomic< std::size_t > nof_requests;
+    std::thread worker;
+    /* ====================  METHODS       ======================================= */
+      void
+    run( );
+
+      void
+    process( std::vector< Request >& requests );
+};  /* -----  end of class Coalescer  ----- */
+
+#endif  // COALESCER_H__
@@ -0,0 +1,407 @@
+/**
+ *    @file  coordinator.h
+ *   @brief  Multi-process fan-out.
+ *
+ *  Locates batches of patterns in forked worker processes sharing the loaded index.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  16:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef COORDINATOR_H__
+#define COORDINATOR_H__
+
+#include <poll.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "locator.h"
+#include "output.h"
+
+
+/**
+ *  @brief  Coordinator of worker processes.
+ *
+ *  Forks worker processes after the indexes are loaded, so that all of them share
+ *  the pages of the indexes (and of the patterns) copy-on-write with the
+ *  coordinator instead of loading their own copy. The coordinator hands out batches
+ *  of patterns to idle workers over pipes; each worker finds and locates its batch
+ *  single-threaded and sends the (seed, node) records back. The coordinator writes
+ *  the records of the batches in order, so the output is the same as that of a
+ *  single process.
+ *
+ *  Workers have their own heaps, so they do not contend on the allocator. A worker
+ *  that dies is replaced by a new fork and its batch is handed out again; a batch
+ *  failing `MAX_ATTEMPTS` times aborts the run.
+ */
+class Coordinator
+{
+  public:
+    /* ====================  CONSTANTS     ======================================= */
+    constexpr static const unsigned int MAX_ATTEMPTS = 3;
+    /** @brief Batches handed out ahead of the next one to be written, per worker. */
+    constexpr static const std::size_t WINDOW_PER_WORKER = 4;
+    /* ====================  LIFECYCLE     ======================================= */
+    /**
+     *  @brief  Coordinator constructor.
+     *
+     *  @param  locators The loaded indexes.
+     *  @param  patterns The patterns to be located in each index.
+     *  @param  nof_workers The number of worker processes.
+     *  @param  batch_size The number of patterns per batch.
+     */
+    Coordinator( const std::vector< Locator >& l, const std::vector< std::string >& p,
+        unsigned int nof_workers, std::size_t batch_size )
+      : locators( l ), patterns( p ), workers( nof_workers ), found( 0 ), paths( 0 ),
+      occurrences( 0 ), restarts( 0 )
+    {
+      for ( std::size_t j = 0; j < this->locators.size(); ++j ) {
+        for ( std::size_t first = 0; first < this->patterns.size(); first += batch_size ) {
+          this->batches.push_back(
+              { j, first, std::min( first + batch_size, this->patterns.size() ) } );
+        }
+      }
+    }
+
+    ~Coordinator( )
+    {
+      /* Workers exit on the end of their request pipe. */
+      for ( auto& worker : this->workers ) this->stop( worker, false );
+    }
+
+    Coordinator( const Coordinator& ) = delete;
+    Coordinator& operator=( const Coordinator& ) = delete;
+    /* ====================  ACCESSORS     ======================================= */
+      inline std::uint64_t
+    get_found( ) const
+    {
+      return this->found;
+    }
+
+      inline std::uint64_t
+    get_paths( ) const
+    {
+      return this->paths;
+    }
+
+      inline std::uint64_t
+    get_occurrences( ) const
+    {
+      return this->occurrences;
+    }
+
+    /**
+     *  @brief  Number of workers replaced after dying.
+     */
+      inline std::uint64_t
+    get_restarts( ) const
+    {
+      return this->restarts;
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Locate all batches and write the occurrences in the j-th index by the
+     *          j-th writer.
+     */
+      inline void
+    run( std::vector< std::unique_ptr< AnyWriter > >& writers )
+    {
+      /* A write to the pipe of a dead worker fails by EPIPE instead. */
+      struct sigaction ignore;
+      struct sigaction previous;
+      ignore.sa_handler = SIG_IGN;
+      sigemptyset( &ignore.sa_mask );
+      ignore.sa_flags = 0;
+      sigaction( SIGPIPE, &ignore, &previous );
+      try {
+        for ( auto& worker : this->workers ) this->spawn( worker );
+        this->dispatch( writers );
+      }
+      catch ( ... ) {
+        sigaction( SIGPIPE, &previous, nullptr );
+        throw;
+      }
+      sigaction( SIGPIPE, &previous, nullptr );
+    }
+  private:
+    /* ====================  MEMBER TYPES  ======================================= */
+    constexpr static const std::size_t IDLE = static_cast< std::size_t >( -1 );
+
+    struct Request {
+      std::uint64_t index;
+      std::uint64_t first;
+      std::uint64_t last;
+    };
+
+    struct Reply {
+      std::uint64_t found;
+      std::uint64_t paths;
+      std::uint64_t records;
+    };
+
+    struct Worker {
+      pid_t pid = -1;
+      int to = -1;                /**< @brief Write end of the request pipe. */
+      int from = -1;              /**< @brief Read end of the reply pipe. */
+      std::size_t batch = IDLE;
+    };
+    /* ====================  DATA MEMBERS  ======================================= */
+    const std::vector< Locator >& locators;
+    const std::vector< std::string >& patterns;
+    std::vector< Request > batches;
+    std::vector< Worker > workers;
+    std::uint64_t found;
+    std::uint64_t paths;
+    std::uint64_t occurrences;
+    std::uint64_t restarts;
+    /* ====================  METHODS       ======================================= */
+      static inline bool
+    read_all( int fd, void* data, std::size_t size )
+    {
+      char* ptr = static_cast< char* >( data );
+      while ( size != 0 ) {
+        ssize_t n = ::read( fd, ptr, size );
+        if ( n < 0 && errno == EINTR ) continue;
+        if ( n <= 0 ) return false;
+        ptr += n;
+        size -= n;
+      }
+      return true;
+    }
+
+      static inline bool
+    write_all( int fd, const void* data, std::size_t size )
+    {
+      const char* ptr = static_cast< const char* >( data );
+      while ( size != 0 ) {
+        ssize_t n = ::write( fd, ptr, size );
+        if ( n < 0 && errno == EINTR ) continue;
+        if ( n <= 0 ) return false;
+        ptr += n;
+        size -= n;
+      }
+      return true;
+    }
+
+    /**
+     *  @brief  Fork a worker.
+     */
+      inline void
+    spawn( Worker& worker )
+    {
+      int request[ 2 ];
+      int reply[ 2 ];
+      if ( pipe( request ) != 0 ) throw std::runtime_error( "could not create pipe" );
+      if ( pipe( reply ) != 0 ) {
+        close( request[ 0 ] );
+        close( request[ 1 ] );
+        throw std::runtime_error( "could not create pipe" );
+      }
+      /* Buffered output would otherwise be written by the worker as well. */
+      std::cout.flush();
+      std::cerr.flush();
+      pid_t pid = fork();
+      if ( pid < 0 ) {
+        for ( int fd : { request[ 0 ], request[ 1 ], reply[ 0 ], reply[ 1 ] } ) close( fd );
+        throw std::runtime_error( "could not fork worker" );
+      }
+      if ( pid == 0 ) {
+        /* Close the pipes of the other workers so that they see their end. */
+        for ( const auto& other : this->workers ) {
+          if ( other.to != -1 ) close( other.to );
+          if ( other.from != -1 ) close( other.from );
+        }
+        close( request[ 1 ] );
+        close( reply[ 0 ] );
+        int status = EXIT_FAILURE;
+        try {
+          status = this->serve( request[ 0 ], reply[ 1 ] );
+        }
+        catch ( const std::exception& e ) {
+          std::cerr << "worker " << getpid() << ": " << e.what() << std::endl;
+        }
+        _exit( status );
+      }
+      close( request[ 0 ] );
+      close( reply[ 1 ] );
+      worker.pid = pid;
+      worker.to = request[ 1 ];
+      worker.from = reply[ 0 ];
+      worker.batch = IDLE;
+    }
+
+    /**
+     *  @brief  Close the pipes of a worker and reap it.
+     *
+     *  @param  kill Whether to kill the worker instead of letting it finish.
+     */
+      inline void
+    stop( Worker& worker, bool kill )
+    {
+      if ( worker.pid == -1 ) return;
+      if ( kill ) ::kill( worker.pid, SIGKILL );
+      close( worker.to );
+      close( worker.from );
+      int status;
+      while ( waitpid( worker.pid, &status, 0 ) < 0 && errno == EINTR );
+      worker = Worker();
+    }
+
+    /**
+     *  @brief  Main loop of a worker process.
+     *
+     *  @return the exit status of the worker.
+     */
+      inline int
+    serve( int in, int out )
+    {
+      Hits hits;
+      std::vector< std::uint64_t > records;
+      Request request;
+      while ( Coordinator::read_all( in, &request, sizeof( request ) ) ) {
+        this->locators[ request.index ].locate( this->patterns.begin() + request.first,
+            this->patterns.begin() + request.last, hits );
+        Reply reply = { 0, 0, 0 };
+        records.clear();
+        for ( std::size_t i = 0; i < hits.size(); ++i ) {
+          if ( gcsa::Range::empty( hits.ranges[ i ] ) ) continue;
+          ++reply.found;
+          reply.paths += this->locators[ request.index ].count( hits.ranges[ i ] );
+          for ( auto it = hits.begin( i ); it != hits.end( i ); ++it ) {
+            records.push_back( request.first + i );
+            records.push_back( *it );
+          }
+        }
+        reply.records = records.size() / 2;
+        if ( !Coordinator::write_all( out, &reply, sizeof( reply ) )
+            || !Coordinator::write_all( out, records.data(),
+              records.size() * sizeof( std::uint64_t ) ) ) {
+          return EXIT_FAILURE;
+        }
+      }
+      return EXIT_SUCCESS;
+    }
+
+    /**
+     *  @brief  Hand out the batches and write their results in order.
+     */
+      inline void
+    dispatch( std::vector< std::unique_ptr< AnyWriter > >& writers )
+    {
+      std::size_t window = WINDOW_PER_WORKER * this->workers.size();
+      std::size_t next = 0;           /* the next batch not handed out yet */
+      std::size_t next_write = 0;     /* the next batch to be written */
+      std::deque< std::size_t > retries;
+      std::vector< unsigned int > attempts( this->batches.size(), 0 );
+      std::map< std::size_t, std::vector< std::uint64_t > > done;
+      std::vector< pollfd > fds;
+      std::vector< Worker* > busy;
+      std::vector< std::uint64_t > nodes;
+
+      auto fail = [&]( Worker& worker ) {
+        std::size_t batch = worker.batch;
+        this->stop( worker, true );
+        if ( ++attempts[ batch ] >= MAX_ATTEMPTS ) {
+          throw std::runtime_error( "batch " + std::to_string( batch ) + " failed in "
+              + std::to_string( MAX_ATTEMPTS ) + " workers" );
+        }
+        std::cerr << "Worker died; restarting it." << std::endl;
+        retries.push_front( batch );
+        ++this->restarts;
+        this->spawn( worker );
+      };
+
+      while ( next_write < this->batches.size() ) {
+        for ( auto& worker : this->workers ) {
+          /* A worker failing to take its batch is replaced by an idle one, to which
+           * the batch is handed out again. */
+          while ( worker.batch == IDLE ) {
+            if ( !retries.empty() ) {
+              worker.batch = retries.front();
+              retries.pop_front();
+            }
+            else if ( next < this->batches.size() && next < next_write + window ) {
+              worker.batch = next++;
+            }
+            else break;
+            const Request& request = this->batches[ worker.batch ];
+            if ( !Coordinator::write_all( worker.to, &request, sizeof( request ) ) ) {
+              fail( worker );
+            }
+          }
+        }
+
+        fds.clear();
+        busy.clear();
+        for ( auto& worker : this->workers ) {
+          if ( worker.batch == IDLE ) continue;
+          fds.push_back( { worker.from, POLLIN, 0 } );
+          busy.push_back( &worker );
+        }
+        /* Nothing to wait for; never block in `poll` without descriptors. */
+        if ( fds.empty() ) continue;
+        if ( poll( fds.data(), fds.size(), -1 ) < 0 ) {
+          if ( errno == EINTR ) continue;
+          throw std::runtime_error( "poll failed" );
+        }
+        for ( std::size_t k = 0; k < fds.size(); ++k ) {
+          if ( fds[ k ].revents == 0 ) continue;
+          Worker& worker = *busy[ k ];
+          Reply reply;
+          std::vector< std::uint64_t > records;
+          if ( !Coordinator::read_all( worker.from, &reply, sizeof( reply ) ) ) {
+            fail( worker );
+            continue;
+          }
+          records.resize( 2 * reply.records );
+          if ( !Coordinator::read_all( worker.from, records.data(),
+                records.size() * sizeof( std::uint64_t ) ) ) {
+            fail( worker );
+            continue;
+          }
+          this->found += reply.found;
+          this->paths += reply.paths;
+          done[ worker.batch ].swap( records );
+          worker.batch = IDLE;
+        }
+
+        /* Write the finished batches in order. */
+        for ( auto it = done.begin(); it != done.end() && it->first == next_write;
+            it = done.erase( it ), ++next_write ) {
+          auto& writer = *writers[ this->batches[ next_write ].index ];
+          const auto& records = it->second;
+          for ( std::size_t r = 0; r < records.size(); ) {
+            std::uint64_t seed = records[ r ];
+            nodes.clear();
+            for ( ; r < records.size() && records[ r ] == seed; r += 2 ) {
+              nodes.push_back( records[ r + 1 ] );
+            }
+            writer.write( seed, nodes );
+          }
+          this->occurrences += records.size() / 2;
+        }
+      }
+    }
+};  /* -----  end of class Coordinator  ----- */
+
+#endif  // COORDINATOR_H__
@@ -0,0 +1,235 @@
+/**
+ *    @file  gcsalocate.cc
+ *   @brief  C interface of the seed locator.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  23:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+#include "locator.h"
+#include "gcsalocate.h"
+
+
+/* Definition of the opaque handle. */
+struct gcsalocate {
+  Locator locator;
+};
+
+static_assert( sizeof( gcsalocate_node_t ) == sizeof( gcsa::node_type ),
+    "node type of the C interface does not match the one of GCSA2" );
+
+namespace {
+  thread_local std::string last_error;
+
+  /**
+   *  @brief  Run a function and turn any exception into a status code.
+   *
+   *  Exceptions must not propagate through the C interface.
+   */
+  template< typename TFunction >
+      inline gcsalocate_status
+    guard( TFunction function )
+    {
+      try {
+        return function();
+      }
+      catch ( const std::exception& e ) {
+        last_error = e.what();
+      }
+      catch ( ... ) {
+        last_error = "unknown error";
+      }
+      return GCSALOCATE_ERROR;
+    }
+
+    inline gcsalocate_status
+  invalid( const std::string& msg )
+  {
+    last_error = msg;
+    return GCSALOCATE_INVALID;
+  }
+
+  /**
+   *  @brief  Check that the non-empty ranges are within the index.
+   *
+   *  Out-of-bounds ranges would make GCSA2 read past its arrays.
+   */
+    inline bool
+  valid_ranges( const gcsalocate_t* handle, const gcsalocate_range_t* ranges, size_t n )
+  {
+    uint64_t size = handle->locator.get_index().size();
+    for ( std::size_t i = 0; i < n; ++i ) {
+      if ( ranges[ i ].first <= ranges[ i ].last && ranges[ i ].last >= size ) return false;
+    }
+    return true;
+  }
+}  /* -----  end of anonymous namespace  ----- */
+
+
+  int
+gcsalocate_abi_version( void )
+{
+  return GCSALOCATE_ABI_VERSION;
+}
+
+
+  const char*
+gcsalocate_last_error( void )
+{
+  return last_error.c_str();
+}
+
+
+  gcsalocate_status
+gcsalocate_load( const char* filename, gcsalocate_t** handle )
+{
+  if ( handle == nullptr ) return invalid( "null handle pointer" );
+  *handle = nullptr;
+  if ( filename == nullptr ) return invalid( "null file name" );
+  return guard( [&]( ) {
+      gcsalocate_t* retval = new gcsalocate_t;
+      try {
+        retval->locator.load( filename );
+      }
+      catch ( ... ) {
+        delete retval;
+        throw;
+      }
+      *handle = retval;
+      return GCSALOCATE_OK;
+      } );
+}
+
+
+  void
+gcsalocate_free( gcsalocate_t* handle )
+{
+  delete handle;
+}
+
+
+  uint64_t
+gcsalocate_order( const gcsalocate_t* handle )
+{
+  return handle == nullptr ? 0 : handle->locator.order();
+}
+
+
+  gcsalocate_status
+gcsalocate_find( const gcsalocate_t* handle, const char* text, const uint64_t* offsets,
+    size_t n, gcsalocate_range_t* ranges )
+{
+  if ( handle == nullptr ) return invalid( "null handle" );
+  if ( n == 0 ) return GCSALOCATE_OK;
+  if ( text == nullptr || offsets == nullptr || ranges == nullptr ) {
+    return invalid( "null argument" );
+  }
+  for ( std::size_t i = 0; i < n; ++i ) {
+    if ( offsets[ i ] > offsets[ i + 1 ] ) return invalid( "decreasing offsets" );
+  }
+  return guard( [&]( ) {
+#pragma omp parallel for schedule( dynamic, 1024 )
+      for ( std::size_t i = 0; i < n; ++i ) {
+        auto range = handle->locator.find( text + offsets[ i ], text + offsets[ i + 1 ] );
+        ranges[ i ] = { range.first, range.second };
+      }
+      return GCSALOCATE_OK;
+      } );
+}
+
+
+  gcsalocate_status
+gcsalocate_count( const gcsalocate_t* handle, const gcsalocate_range_t* ranges, size_t n,
+    uint64_t* counts )
+{
+  if ( handle == nullptr ) return invalid( "null handle" );
+  if ( n == 0 ) return GCSALOCATE_OK;
+  if ( ranges == nullptr || counts == nullptr ) return invalid( "null argument" );
+  if ( !valid_ranges( handle, ranges, n ) ) return invalid( "range out of bounds" );
+  return guard( [&]( ) {
+#pragma omp parallel for schedule( dynamic, 64 )
+      for ( std::size_t i = 0; i < n; ++i ) {
+        Locator::range_type range( ranges[ i ].first, ranges[ i ].last );
+        counts[ i ] = gcsa::Range::empty( range ) ? 0 : handle->locator.count( range );
+      }
+      return GCSALOCATE_OK;
+      } );
+}
+
+
+  gcsalocate_status
+gcsalocate_locate( const gcsalocate_t* handle, const gcsalocate_range_t* ranges,
+    size_t n, gcsalocate_node_t* nodes, size_t capacity, uint64_t* offsets,
+    uint64_t* total )
+{
+  if ( total != nullptr ) *total = 0;
+  if ( handle == nullptr ) return invalid( "null handle" );
+  if ( offsets == nullptr || ( n != 0 && ranges == nullptr )
+      || ( capacity != 0 && nodes == nullptr ) ) {
+    return invalid( "null argument" );
+  }
+  if ( !valid_ranges( handle, ranges, n ) ) return invalid( "range out of bounds" );
+  return guard( [&]( ) {
+      /* Ranges are located in parallel into per-range buffers, which are reused
+       * among the calls of a thread (as in `Locator::locate`), then copied to the
+       * caller's buffer in parallel at the offsets given by their prefix sums. */
+      thread_local std::vector< Locator::nodes_type > buffers;
+      /* Within the parallel region, `buffers` would name the buffers of each thread. */
+      auto& results = buffers;
+      if ( results.size() < n ) results.resize( n );
+#pragma omp parallel for schedule( dynamic, 64 )
+      for ( std::size_t i = 0; i < n; ++i ) {
+        Locator::range_type range( ranges[ i ].first, ranges[ i ].last );
+        results[ i ].clear();
+        if ( !gcsa::Range::empty( range ) ) handle->locator.locate( range, results[ i ] );
+      }
+      offsets[ 0 ] = 0;
+      for ( std::size_t i = 0; i < n; ++i ) {
+        offsets[ i + 1 ] = offsets[ i ] + results[ i ].size();
+      }
+      uint64_t size = offsets[ n ];
+      if ( total != nullptr ) *total = size;
+      if ( size > capacity ) {
+        last_error = "output buffer is too small";
+        return GCSALOCATE_CAPACITY;
+      }
+#pragma omp parallel for schedule( dynamic, 64 )
+      for ( std::size_t i = 0; i < n; ++i ) {
+        std::copy( results[ i ].begin(), results[ i ].end(), nodes + offsets[ i ] );
+      }
+      return GCSALOCATE_OK;
+      } );
+}
+
+
+  uint64_t
+gcsalocate_node_id( gcsalocate_node_t node )
+{
+  return gcsa::Node::id( node );
+}
+
+
+  uint64_t
+gcsalocate_node_offset( gcsalocate_node_t node )
+{
+  return gcsa::Node::offset( node );
+}
+
+
+  int
+gcsalocate_node_is_reverse( gcsalocate_node_t node )
+{
+  return gcsa::Node::rc( node );
+}
@@ -0,0 +1,148 @@
+/**
+ *    @file  gcsalocate.h
+ *   @brief  C interface of the seed locator.
+ *
+ *  A stable C ABI over `Locator` for calling the engine from other languages.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  23:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef GCSALOCATE_H__
+#define GCSALOCATE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Version of the ABI; incremented on incompatible changes. */
+#define GCSALOCATE_ABI_VERSION 1
+
+/** @brief Status codes. */
+typedef enum {
+  GCSALOCATE_OK = 0,
+  GCSALOCATE_ERROR = 1,           /**< @brief Failure; see `gcsalocate_last_error`. */
+  GCSALOCATE_INVALID = 2,         /**< @brief Invalid argument, e.g. a NULL handle. */
+  GCSALOCATE_CAPACITY = 3         /**< @brief Output buffer is too small. */
+} gcsalocate_status;
+
+/** @brief Opaque handle of a loaded index. */
+typedef struct gcsalocate gcsalocate_t;
+
+/** @brief Node position as encoded by GCSA2. */
+typedef uint64_t gcsalocate_node_t;
+
+/** @brief Inclusive range of paths in the index; empty if `first > last`. */
+typedef struct {
+  uint64_t first;
+  uint64_t last;
+} gcsalocate_range_t;
+
+/**
+ *  @brief  ABI version of the library; should be equal to `GCSALOCATE_ABI_VERSION`.
+ */
+int gcsalocate_abi_version( void );
+
+/**
+ *  @brief  Message of the last error occurred in the calling thread.
+ *
+ *  The returned string is valid until the next call in the same thread.
+ */
+const char* gcsalocate_last_error( void );
+
+/**
+ *  @brief  Load an index.
+ *
+ *  @param  filename Path to the GCSA2 index file.
+ *  @param  handle The handle of the loaded index; NULL on failure.
+ */
+gcsalocate_status gcsalocate_load( const char* filename, gcsalocate_t** handle );
+
+/**
+ *  @brief  Free an index loaded by `gcsalocate_load`; NULL is ignored.
+ */
+void gcsalocate_free( gcsalocate_t* handle );
+
+/**
+ *  @brief  Maximum length of patterns that can be queried.
+ */
+uint64_t gcsalocate_order( const gcsalocate_t* handle );
+
+/**
+ *  @brief  Find the ranges of a batch of patterns.
+ *
+ *  The patterns are given as a single character buffer: pattern `i` is
+ *  `text[ offsets[ i ] ]` up to (excluding) `text[ offsets[ i + 1 ] ]`.
+ *
+ *  @param  handle The index.
+ *  @param  text The concatenated patterns.
+ *  @param  offsets Start offsets of the patterns in `text` (`n + 1` entries).
+ *  @param  n The number of patterns.
+ *  @param  ranges The range of pattern `i` is written to `ranges[ i ]` (`n` entries).
+ *
+ *  The patterns are searched in place in parallel, using the OpenMP threads of the
+ *  caller.
+ */
+gcsalocate_status gcsalocate_find( const gcsalocate_t* handle, const char* text,
+    const uint64_t* offsets, size_t n, gcsalocate_range_t* ranges );
+
+/**
+ *  @brief  Count the distinct occurrences of a batch of ranges.
+ *
+ *  @param  counts The number of occurrences of `ranges[ i ]` is written to
+ *                 `counts[ i ]`; zero for empty ranges (`n` entries).
+ *
+ *  The ranges are counted in parallel, using the OpenMP threads of the caller.
+ *  `GCSALOCATE_INVALID` is returned if a non-empty range exceeds the index.
+ */
+gcsalocate_status gcsalocate_count( const gcsalocate_t* handle,
+    const gcsalocate_range_t* ranges, size_t n, uint64_t* counts );
+
+/**
+ *  @brief  Locate the occurrences of a batch of ranges.
+ *
+ *  The occurrences of `ranges[ i ]` are written, sorted and distinct, to
+ *  `nodes[ offsets[ i ] ]` up to (excluding) `nodes[ offsets[ i + 1 ] ]`. The sum
+ *  of `gcsalocate_count` over the ranges is the required capacity.
+ *
+ *  @param  nodes Output buffer of `capacity` entries.
+ *  @param  capacity The capacity of `nodes`.
+ *  @param  offsets Offsets of the occurrences of each range in `nodes` (`n + 1`
+ *                  entries).
+ *  @param  total The total number of occurrences; if it exceeds `capacity`,
+ *                `GCSALOCATE_CAPACITY` is returned and `nodes` and `offsets` are
+ *                unspecified. May be NULL.
+ *
+ *  The ranges are located in parallel, using the OpenMP threads of the caller, into
+ *  buffers kept by the calling thread for reuse by its later calls, and then
+ *  copied to `nodes`. `GCSALOCATE_INVALID` is returned if a non-empty range
+ *  exceeds the index.
+ */
+gcsalocate_status gcsalocate_locate( const gcsalocate_t* handle,
+    const gcsalocate_range_t* ranges, size_t n, gcsalocate_node_t* nodes,
+    size_t capacity, uint64_t* offsets, uint64_t* total );
+
+/** @brief Node identifier of an occurrence. */
+uint64_t gcsalocate_node_id( gcsalocate_node_t node );
+
+/** @brief Offset of an occurrence in its node. */
+uint64_t gcsalocate_node_offset( gcsalocate_node_t node );
+
+/** @brief Whether an occurrence is on the reverse strand. */
+int gcsalocate_node_is_reverse( gcsalocate_node_t node );
+
+#ifdef __cplusplus
+}  /* -----  end of extern "C"  ----- */
+#endif
+
+#endif  // GCSALOCATE_H__
@@ -0,0 +1,153 @@
+/**
+ *    @file  kmer.h
+ *   @brief  k-mers packed in a machine word.
+ *
+ *  k-mers of length at most 32 packed in 2-bit codes in a `std::uint64_t`, with the
+ *  length as a template parameter dispatched from the runtime seed length.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Mon Oct 19, 2026  10:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef KMER_H__
+#define KMER_H__
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "seed.h"
+
+
+/**
+ *  @brief  k-mer of length `K` packed in a 64-bit word.
+ *
+ *  The first base is in the most significant position, so that the value of a
+ *  k-mer is its 2-bit code (A=0, C=1, G=2, T=3) read as a base-4 number, and the
+ *  last base is in the two least significant bits.
+ */
+template< unsigned int K >
+  struct PackedKmer {
+    static_assert( 0 < K && K <= 32, "packed k-mers are at most 32 bases long" );
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef std::uint64_t value_type;
+    /* ====================  CONSTANTS     ======================================= */
+    constexpr static value_type MASK =
+      K == 32 ? ~value_type( 0 ) : ( value_type( 1 ) << ( 2 * K ) ) - 1;
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Append a base to a k-mer dropping its first base.
+     */
+      static inline value_type
+    roll( value_type kmer, std::uint8_t code )
+    {
+      return ( ( kmer << 2 ) | code ) & MASK;
+    }
+
+    /**
+     *  @brief  Pack the k-mer starting at `pos` of a text.
+     *
+     *  The text must hold only A, C, G and T in [pos, pos + K).
+     */
+    template< typename TText >
+        static inline value_type
+      encode( const TText& text, std::size_t pos = 0 )
+      {
+        value_type kmer = 0;
+        for ( std::size_t i = pos; i < pos + K; ++i ) {
+          kmer = ( kmer << 2 ) | seed_hash::encode( text[ i ] );
+        }
+        return kmer;
+      }
+
+    /**
+     *  @brief  Unpack a k-mer into a string.
+     */
+      static inline std::string
+    decode( value_type kmer )
+    {
+      std::string str( K, 'A' );
+      for ( unsigned int i = K; i != 0; --i, kmer >>= 2 ) str[ i - 1 ] = "ACGT"[ kmer & 3 ];
+      return str;
+    }
+  };  /* -----  end of template struct PackedKmer  ----- */
+
+/**
+ *  @brief  Add k-mers with `step` distance to a packed seed set.
+ *
+ *  @param  seeds The packed seed set.
+ *  @param  string_set The string set from which seeds are extracted.
+ *  @param  step The step size.
+ *
+ *  Gives the same seeds as the `seeding` overload taking a step size in the same
+ *  order, packed. Each k-mer is rolled from the previous one in constant time.
+ */
+template< unsigned int K, typename TText >
+    inline void
+  packed_seeding( std::vector< std::uint64_t >& seeds,
+      const std::vector< TText >& string_set,
+      unsigned int step )
+  {
+    for ( const auto& text : string_set ) {
+      for_each_stretch( text, K, [&]( std::size_t begin, std::size_t end ) {
+          std::uint64_t kmer = 0;
+          std::size_t next = begin + K - 1;     /* last base of the next seed */
+          for ( std::size_t i = begin; i < end; ++i ) {
+            kmer = PackedKmer< K >::roll( kmer, seed_hash::encode( text[ i ] ) );
+            if ( i == next ) {
+              seeds.push_back( kmer );
+              next += step;
+            }
+          }
+        } );
+    }
+  }  /* -----  end of template function packed_seeding  ----- */
+
+/**
+ *  @brief  Pack a set of seeds of length `K` holding only A, C, G and T.
+ */
+template< unsigned int K, typename TText >
+    inline void
+  pack( std::vector< std::uint64_t >& kmers, const std::vector< TText >& seeds )
+  {
+    kmers.clear();
+    kmers.reserve( seeds.size() );
+    for ( const auto& seed : seeds ) kmers.push_back( PackedKmer< K >::encode( seed ) );
+  }  /* -----  end of template function pack  ----- */
+
+/**
+ *  @brief  Call a function with the seed length as a compile-time constant.
+ *
+ *  @param  k The seed length.
+ *  @param  callback Called as `callback( std::integral_constant< unsigned int, k >() )`
+ *                   if `k` is one of the supported lengths.
+ *  @return false if `k` is not supported, in which case the callback is not called.
+ *
+ *  Only the common seed lengths are instantiated to bound the code size.
+ */
+template< typename TCallback >
+    inline bool
+  dispatch_packed( unsigned int k, TCallback&& callback )
+  {
+    switch ( k ) {
+      case 8: callback( std::integral_constant< unsigned int, 8 >() ); return true;
+      case 12: callback( std::integral_constant< unsigned int, 12 >() ); return true;
+      case 16: callback( std::integral_constant< unsigned int, 16 >() ); return true;
+      case 20: callback( std::integral_constant< unsigned int, 20 >() ); return true;
+      case 24: callback( std::integral_constant< unsigned int, 24 >() ); return true;
+      case 28: callback( std::integral_constant< unsigned int, 28 >() ); return true;
+      case 31: callback( std::integral_constant< unsigned int, 31 >() ); return true;
+      case 32: callback( std::integral_constant< unsigned int, 32 >() ); return true;
+      default: return false;
+    }
+  }  /* -----  end of template function dispatch_packed  ----- */
+
+#endif  /* ----- #ifndef KMER_H__  ----- */
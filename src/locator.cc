@@ -0,0 +1,78 @@
+/**
+ *    @file  locator.cc
+ *   @brief  Seed locator implementation.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  22:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <fstream>
+#include <stdexcept>
+
+#include "locator.h"
+
+
+Locator::Locator( const std::string& gcsa_filename )
+{
+  this->load( gcsa_filename );
+}
+
+
+  void
+Locator::load( const std::string& gcsa_filename )
+{
+  std::ifstream gcsa_file( gcsa_filename, std::ifstream::in | std::ifstream::binary );
+  if ( !gcsa_file ) {
+    throw std::runtime_error("could not open file '" + gcsa_filename + "'" );
+  }
+  this->load( gcsa_file );
+}
+
+
+  void
+Locator::load( std::istream& in )
+{
+  this->index.load( in );
+  for ( std::size_t c = 0; c < this->codes.size(); ++c ) {
+    this->codes[ c ] = this->index.alpha.char2comp[ static_cast< unsigned char >( "ACGT"[ c ] ) ];
+  }
+}
+
+
+  Locator::size_type
+Locator::find( const std::vector< std::string >& patterns,
+    std::vector< range_type >& ranges ) const
+{
+  size_type total = 0;
+  ranges.resize( patterns.size() );
+#pragma omp parallel for schedule( dynamic, 1024 ) reduction( +:total )
+  for ( std::size_t i = 0; i < patterns.size(); ++i ) {
+    ranges[ i ] = this->index.find( patterns[ i ] );
+    if ( !gcsa::Range::empty( ranges[ i ] ) ) {
+      total += this->index.count( ranges[ i ] );
+    }
+  }
+  return total;
+}
+
+
+  Locator::size_type
+Locator::locate( const std::vector< range_type >& ranges,
+    std::vector< nodes_type >& results ) const
+{
+  size_type total = 0;
+  if ( results.size() < ranges.size() ) results.resize( ranges.size() );
+#pragma omp parallel for schedule( dynamic, 64 ) reduction( +:total )
+  for ( std::size_t i = 0; i < ranges.size(); ++i ) {
+    this->index.locate( ranges[ i ], results[ i ] );
+    total += results[ i ].size();
+  }
+  return total;
+}
@@ -0,0 +1,546 @@
+/**
+ *    @file  locator.h
+ *   @brief  Seed locator.
+ *
+ *  Locates k-mers in the variation graph using a GCSA2 index.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  22:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef LOCATOR_H__
+#define LOCATOR_H__
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <utility>
+
+#include <gcsa/gcsa.h>
+
+
+/**
+ *  @brief  Occurrences of a batch of patterns in flat buffers.
+ *
+ *  The occurrences of pattern `i` are `nodes[ offsets[ i ] ]` up to (excluding)
+ *  `nodes[ offsets[ i + 1 ] ]`, sorted and distinct, and `ranges[ i ]` is its range
+ *  (empty if it does not occur). `clear` keeps the capacity of the buffers, so a
+ *  `Hits` reused among batches stops allocating once it has grown to the largest
+ *  batch.
+ */
+struct Hits {
+  /* ====================  MEMBER TYPES  ======================================= */
+  typedef gcsa::size_type size_type;
+  typedef gcsa::node_type node_type;
+  typedef gcsa::range_type range_type;
+  /* ====================  DATA MEMBERS  ======================================= */
+  std::vector< range_type > ranges;
+  std::vector< size_type > offsets;
+  std::vector< node_type > nodes;
+  /* ====================  ACCESSORS     ======================================= */
+  /**
+   *  @brief  Number of patterns in the batch.
+   */
+    inline size_type
+  size( ) const
+  {
+    return this->ranges.size();
+  }
+
+  /**
+   *  @brief  Number of occurrences of pattern `i`.
+   */
+    inline size_type
+  count( size_type i ) const
+  {
+    return this->offsets[ i + 1 ] - this->offsets[ i ];
+  }
+
+    inline const node_type*
+  begin( size_type i ) const
+  {
+    return this->nodes.data() + this->offsets[ i ];
+  }
+
+    inline const node_type*
+  end( size_type i ) const
+  {
+    return this->nodes.data() + this->offsets[ i + 1 ];
+  }
+  /* ====================  METHODS       ======================================= */
+    inline void
+  clear( )
+  {
+    this->ranges.clear();
+    this->offsets.clear();
+    this->nodes.clear();
+  }
+};  /* -----  end of struct Hits  ----- */
+
+/**
+ *  @brief  Backward search of the bases `I` to `K - 1` from the end of a packed k-mer.
+ *
+ *  Each step is a separate instantiation, so the loop over the bases is fully
+ *  unrolled for a given `K`.
+ */
+template< unsigned int K, unsigned int I >
+  struct BackwardSearch {
+      static inline gcsa::range_type
+    extend( const gcsa::GCSA& index, const gcsa::comp_type* codes, std::uint64_t kmer,
+        gcsa::range_type range )
+    {
+      if ( gcsa::Range::empty( range ) ) return range;
+      range = index.LF( range, codes[ ( kmer >> ( 2 * I ) ) & 3 ] );
+      return BackwardSearch< K, I + 1 >::extend( index, codes, kmer, range );
+    }
+  };
+
+template< unsigned int K >
+  struct BackwardSearch< K, K > {
+      static inline gcsa::range_type
+    extend( const gcsa::GCSA&, const gcsa::comp_type*, std::uint64_t,
+        gcsa::range_type range )
+    {
+      return range;
+    }
+  };
+
+/**
+ *  @brief  Seed locator owning a GCSA2 index.
+ *
+ *  The query methods are `const` and can be called concurrently; the batch methods
+ *  run in parallel using the OpenMP threads of the caller.
+ */
+class Locator
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef gcsa::size_type size_type;
+    typedef gcsa::node_type node_type;
+    typedef gcsa::range_type range_type;
+    typedef std::vector< node_type > nodes_type;
+    /* ====================  LIFECYCLE     ======================================= */
+    Locator( ) = default;
+    /**
+     *  @brief  Load the index from the given file.
+     */
+    explicit Locator( const std::string& gcsa_filename );
+    /* ====================  ACCESSORS     ======================================= */
+    /**
+     *  @brief  The underlying index.
+     */
+      inline const gcsa::GCSA&
+    get_index( ) const
+    {
+      return this->index;
+    }
+
+    /**
+     *  @brief  Maximum length of the patterns that can be queried.
+     */
+      inline size_type
+    order( ) const
+    {
+      return this->index.order();
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Load the index from a file; replaces the current index.
+     */
+      void
+    load( const std::string& gcsa_filename );
+
+    /**
+     *  @brief  Load the index from a stream; replaces the current index.
+     */
+      void
+    load( std::istream& in );
+
+    /**
+     *  @brief  Find the range of the paths matching the pattern.
+     *
+     *  @return an empty range (see `gcsa::Range::empty`) if the pattern does not occur.
+     */
+      inline range_type
+    find( const std::string& pattern ) const
+    {
+      return this->index.find( pattern );
+    }
+
+    /**
+     *  @brief  Find the range of the paths matching the pattern [first, last).
+     *
+     *  The pattern is searched in place, so it need not be copied into a string.
+     */
+    template< typename TIter >
+        inline range_type
+      find( TIter first, TIter last ) const
+      {
+        return this->index.find( first, last );
+      }
+
+    /**
+     *  @brief  Find the shortest suffix of a text specific enough.
+     *
+     *  @param  first The beginning of the text.
+     *  @param  last The end of the text; the suffix ends here.
+     *  @param  min_len The minimum length of the suffix.
+     *  @param  target The number of occurrences below which the suffix is specific.
+     *  @param  len The length of the suffix found.
+     *  @return the range of the suffix of length `len`.
+     *
+     *  The backward search is extended past `min_len` characters until the suffix
+     *  has at most `target` occurrences (see `count`) or the text is exhausted, so
+     *  `last - first` is the maximum length. If a longer suffix does not occur, the
+     *  search stops at the longest occurring one. The returned range is empty if a
+     *  suffix shorter than `min_len` does not occur or the text is shorter than it.
+     */
+    template< typename TIter >
+        inline range_type
+      find_adaptive( TIter first, TIter last, size_type min_len, size_type target,
+          size_type& len ) const
+      {
+        range_type range( 1, 0 );
+        len = 0;
+        while ( last != first ) {
+          --last;
+          auto comp = this->index.alpha.char2comp[ static_cast< unsigned char >( *last ) ];
+          range_type next = len == 0 ? this->index.charRange( comp )
+            : this->index.LF( range, comp );
+          if ( gcsa::Range::empty( next ) ) break;
+          range = next;
+          if ( ++len >= min_len && this->index.count( range ) <= target ) break;
+        }
+        if ( len < min_len ) return range_type( 1, 0 );
+        return range;
+      }
+
+    /**
+     *  @brief  Find the range of the paths matching a packed k-mer (see `PackedKmer`).
+     *
+     *  Gives the same range as `find` on the unpacked k-mer.
+     */
+    template< unsigned int K >
+        inline range_type
+      find( std::uint64_t kmer ) const
+      {
+        range_type range = this->index.charRange( this->codes[ kmer & 3 ] );
+        return BackwardSearch< K, 1 >::extend( this->index, this->codes.data(), kmer, range );
+      }
+
+    /**
+     *  @brief  Find the ranges of a batch of packed k-mers in parallel.
+     *
+     *  @param  kmers The packed k-mers of length `K`.
+     *  @param  ranges The range of `kmers[i]` is stored in `ranges[i]`.
+     *  @return the total number of paths matching the k-mers.
+     */
+    template< unsigned int K >
+        inline size_type
+      find( const std::vector< std::uint64_t >& kmers,
+          std::vector< range_type >& ranges ) const
+      {
+        size_type total = 0;
+        ranges.resize( kmers.size() );
+#pragma omp parallel for schedule( dynamic, 1024 ) reduction( +:total )
+        for ( std::size_t i = 0; i < kmers.size(); ++i ) {
+          ranges[ i ] = this->find< K >( kmers[ i ] );
+          if ( !gcsa::Range::empty( ranges[ i ] ) ) {
+            total += this->index.count( ranges[ i ] );
+          }
+        }
+        return total;
+      }
+
+    /**
+     *  @brief  Number of distinct occurrences in the range.
+     */
+      inline size_type
+    count( range_type range ) const
+    {
+      return this->index.count( range );
+    }
+
+    /**
+     *  @brief  Locate the occurrences in the range.
+     *
+     *  @param  range A non-empty range returned by `find`.
+     *  @param  results The occurrences; previous contents are replaced.
+     */
+      inline void
+    locate( range_type range, nodes_type& results ) const
+    {
+      this->index.locate( range, results );
+    }
+
+    /**
+     *  @brief  Locate the occurrences of a pattern.
+     *
+     *  @param  pattern The pattern to be located.
+     *  @param  results The occurrences; empty if the pattern does not occur.
+     *  @return `true` if the pattern occurs.
+     */
+      inline bool
+    locate( const std::string& pattern, nodes_type& results ) const
+    {
+      range_type range = this->find( pattern );
+      if ( gcsa::Range::empty( range ) ) {
+        results.clear();
+        return false;
+      }
+      this->locate( range, results );
+      return true;
+    }
+
+    /**
+     *  @brief  Find the ranges of a batch of patterns in parallel.
+     *
+     *  @param  patterns The patterns.
+     *  @param  ranges The range of `patterns[i]` is stored in `ranges[i]`.
+     *  @return the total number of paths matching the patterns.
+     */
+      size_type
+    find( const std::vector< std::string >& patterns,
+        std::vector< range_type >& ranges ) const;
+
+    /**
+     *  @brief  Locate the occurrences of a batch of ranges in parallel.
+     *
+     *  @param  ranges Non-empty ranges returned by `find`.
+     *  @param  results The occurrences of `ranges[i]` are stored in `results[i]`; it
+     *                  is grown to the number of ranges if it is smaller, but never
+     *                  shrunk so that the buffers can be reused among batches.
+     *  @return the total number of occurrences.
+     */
+      size_type
+    locate( const std::vector< range_type >& ranges,
+        std::vector< nodes_type >& results ) const;
+
+    /**
+     *  @brief  Find and locate a batch of patterns into caller-provided buffers.
+     *
+     *  @param  first The first pattern.
+     *  @param  last The end of the patterns.
+     *  @param  hits The ranges and occurrences of the patterns; previous contents are
+     *               cleared but the buffers are reused.
+     *
+     *  Occurrences are appended to `hits.nodes` directly, so no per-pattern result
+     *  vector is allocated. It runs in the calling thread; concurrent callers should
+     *  each use their own `Hits`.
+     */
+    template< typename TIter >
+        inline void
+      locate( TIter first, TIter last, Hits& hits ) const
+      {
+        hits.clear();
+        hits.offsets.push_back( 0 );
+        for ( ; first != last; ++first ) {
+          range_type range = this->index.find( *first );
+          hits.ranges.push_back( range );
+          if ( !gcsa::Range::empty( range ) ) {
+            auto begin = hits.nodes.size();
+            this->index.locate( range, hits.nodes, true, false );
+            std::sort( hits.nodes.begin() + begin, hits.nodes.end() );
+            hits.nodes.erase( std::unique( hits.nodes.begin() + begin, hits.nodes.end() ),
+                hits.nodes.end() );
+          }
+          hits.offsets.push_back( hits.nodes.size() );
+        }
+      }
+
+    /**
+     *  @brief  Locate a batch of patterns calling back for each occurrence.
+     *
+     *  @param  first The first pattern.
+     *  @param  last The end of the patterns.
+     *  @param  callback Called as `callback( i, node )` for each distinct occurrence
+     *                   `node` of the `i`th pattern, in order of the patterns.
+     *  @param  buffer Buffer for the occurrences of one pattern at a time; reused.
+     *
+     *  The callback type is a template parameter so that it is inlined; only the
+     *  occurrences of the pattern being visited are stored at any time. It runs in
+     *  the calling thread.
+     */
+    template< typename TIter, typename TCallback >
+        inline void
+      visit( TIter first, TIter last, TCallback&& callback, nodes_type& buffer ) const
+      {
+        for ( size_type i = 0; first != last; ++first, ++i ) {
+          range_type range = this->index.find( *first );
+          if ( gcsa::Range::empty( range ) ) continue;
+          this->index.locate( range, buffer );
+          for ( const auto& node : buffer ) callback( i, node );
+        }
+      }
+
+    template< typename TIter, typename TCallback >
+        inline void
+      visit( TIter first, TIter last, TCallback&& callback ) const
+      {
+        nodes_type buffer;
+        this->visit( first, last, std::forward< TCallback >( callback ), buffer );
+      }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    gcsa::GCSA index;
+    std::array< gcsa::comp_type, 4 > codes{ };    /**< @brief Comp value of A, C, G, T. */
+};  /* -----  end of class Locator  ----- */
+
+/**
+ *  @brief  Several indexes queried together, e.g. the per-chromosome parts of a graph.
+ *
+ *  The locators must outlive it.
+ */
+class MultiLocator
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef Locator::size_type size_type;
+    typedef Locator::range_type range_type;
+    /* ====================  LIFECYCLE     ======================================= */
+    explicit MultiLocator( const std::vector< Locator >& l )
+      : locators( &l ), ranges( l.size() )
+    { }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Find the shortest suffix of a text specific enough in every index.
+     *
+     *  @param  first The beginning of the text.
+     *  @param  last The end of the text; the suffix ends here.
+     *  @param  min_len The minimum length of the suffix.
+     *  @param  target The number of occurrences below which the suffix is specific.
+     *  @param  len The length of the suffix found.
+     *  @return false if no suffix of `min_len` characters occurs in any index.
+     *
+     *  As `Locator::find_adaptive`, but the suffix is extended while it has more than
+     *  `target` occurrences in any of the indexes; an index in which it does not
+     *  occur has none. The search stops at the longest suffix occurring in some
+     *  index. Not thread-safe; use one per thread.
+     */
+    template< typename TIter >
+        inline bool
+      find_adaptive( TIter first, TIter last, size_type min_len, size_type target,
+          size_type& len )
+      {
+        len = 0;
+        while ( last != first ) {
+          --last;
+          bool occurs = false;
+          for ( std::size_t j = 0; j < this->ranges.size(); ++j ) {
+            const auto& index = ( *this->locators )[ j ].get_index();
+            auto comp = index.alpha.char2comp[ static_cast< unsigned char >( *last ) ];
+            auto& range = this->ranges[ j ];
+            if ( len == 0 ) range = index.charRange( comp );
+            else if ( !gcsa::Range::empty( range ) ) range = index.LF( range, comp );
+            if ( !gcsa::Range::empty( range ) ) occurs = true;
+          }
+          if ( !occurs ) break;
+          if ( ++len >= min_len && this->specific( target ) ) break;
+        }
+        return len >= min_len;
+      }
+  private:
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Whether the current ranges have at most `target` occurrences each.
+     */
+      inline bool
+    specific( size_type target ) const
+    {
+      for ( std::size_t j = 0; j < this->ranges.size(); ++j ) {
+        if ( gcsa::Range::empty( this->ranges[ j ] ) ) continue;
+        if ( ( *this->locators )[ j ].count( this->ranges[ j ] ) > target ) return false;
+      }
+      return true;
+    }
+    /* ====================  DATA MEMBERS  ======================================= */
+    const std::vector< Locator >* locators;
+    std::vector< range_type > ranges;   /**< @brief Ranges of the current suffix. */
+};  /* -----  end of class MultiLocator  ----- */
+
+/**
+ *  @brief  Incremental locate of a range in chunks of occurrences.
+ *
+ *  Locates the paths of the range one at a time in a single forward pass and returns
+ *  the occurrences as soon as a chunk of `chunk_size` of them is collected, so that
+ *  the first occurrences are available after locating only as many paths as needed
+ *  to fill a chunk. The occurrences in a chunk are sorted; an occurrence reached by
+ *  more than one path is returned only once, as the occurrences already returned are
+ *  kept in a set. The chunks are thus disjoint and their union is equal to the result
+ *  of `Locator::locate` whatever the chunk size, while the working memory is the
+ *  chunk, the occurrences of a single path and the set of the distinct occurrences
+ *  returned so far.
+ *
+ *  The locator must outlive the cursor.
+ */
+class LocateCursor
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef Locator::size_type size_type;
+    typedef Locator::range_type range_type;
+    typedef Locator::node_type node_type;
+    typedef Locator::nodes_type nodes_type;
+    /* ====================  LIFECYCLE     ======================================= */
+    LocateCursor( const Locator& l, range_type range, size_type chunk_size )
+      : locator( &l ), path( range.first ), last( range.second ),
+      chunk_size( std::max< size_type >( chunk_size, 1 ) ), pos( 0 )
+    {
+      if ( gcsa::Range::empty( range ) ) this->path = this->last + 1;
+    }
+    /* ====================  ACCESSORS     ======================================= */
+    /**
+     *  @brief  Whether all occurrences of the range are returned.
+     */
+      inline bool
+    done( ) const
+    {
+      return this->path > this->last && this->pos == this->buffer.size();
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Locate the next chunk of occurrences.
+     *
+     *  @param  chunk The occurrences not returned before, sorted; previous contents
+     *                are replaced.
+     *  @return `false` if there is no more occurrence; `chunk` is then empty.
+     */
+      inline bool
+    next( nodes_type& chunk )
+    {
+      chunk.clear();
+      while ( chunk.size() < this->chunk_size && !this->done() ) {
+        if ( this->pos == this->buffer.size() ) {
+          this->locator->get_index().locate( this->path++, this->buffer, false, false );
+          this->pos = 0;
+          continue;
+        }
+        node_type node = this->buffer[ this->pos++ ];
+        if ( this->seen.insert( node ).second ) chunk.push_back( node );
+      }
+      std::sort( chunk.begin(), chunk.end() );
+      return !chunk.empty();
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    const Locator* locator;
+    size_type path;               /**< @brief Next path to be located. */
+    size_type last;
+    size_type chunk_size;
+    nodes_type buffer;            /**< @brief Occurrences of the last path located. */
+    std::size_t pos;              /**< @brief Next occurrence in `buffer`. */
+    std::unordered_set< node_type > seen;
+};  /* -----  end of class LocateCursor  ----- */
+
+#endif  // LOCATOR_H__
@@ -17,17 +17,29 @@
 
 #include <cstdlib>
 #include <csignal>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
+#include <algorithm>
 
+#include <unistd.h>
+#include <omp.h>
 #include <seqan/arg_parse.h>
-#include <gcsa/gcsa.h>
 
 #include <config.h>
-#include "seed.h"
+#include "locator.h"
+#include "pipeline.h"
 #include "timer.h"
+#include "stats.h"
+#include "output.h"
+#include "shard.h"
+#include "checkpoint.h"
+#include "coordinator.h"
 #include "options.h"
 #include "release.h"
 
@@ -42,12 +54,29 @@ setup_argparser( seqan::ArgumentParser& parser );
 get_option_values( Options& options, seqan::ArgumentParser& parser );
 
   void
-locate_seeds( std::string& seq_name, std::string& gcsa_name, unsigned int seed_len,
-    unsigned int distance, std::string& output_name );
+locate_seeds( const Options& options );
+
+  void
+soak( const std::vector< Locator >& locators,
+    const std::vector< std::string >& sequences, const Options& options, Stats& stats );
+
+  void
+fan_out( const std::vector< Locator >& locators, const std::vector< std::string >& patterns,
+    const std::vector< std::string >& output_filenames, const Options& options,
+    Stats& stats );
+
+  void
+write_stats( Stats& stats, const Options& options );
 
   void
 signal_handler( int signal );
 
+/** @brief Number of reads taken by a thread at once in soak mode. */
+constexpr std::size_t SOAK_CHUNK_SIZE = 64;
+
+static_assert( gcsa::Node::OFFSET_BITS == NodeCodec::OFFSET_BITS,
+    "node encoding of GCSA2 does not match the one used by output writers" );
+
 std::size_t done_idx = 0;
 std::size_t total_no = 0;
 std::size_t total_occs = 0;
@@ -67,8 +96,7 @@ main( int argc, char* argv[] )
   /* Install signal handler */
   std::signal( SIGUSR1, signal_handler );
 
-  locate_seeds( options.seq_filename, options.gcsa_filename, options.seed_len,
-      options.distance, options.output_filename );
+  locate_seeds( options );
 
   return EXIT_SUCCESS;
 }
@@ -79,76 +107,472 @@ signal_handler( int )
 {
   std::cout << "Located " << ::done_idx << " out of " << ::total_no
             << " with " << ::total_occs << " occurrences in "
-            << Timer<>::get_lap_str( "locate" ) << ": "
+            << Timer< SteadyClock >::get_lap_str( "locate" ) << ": "
             << ::done_idx * 100 / total_no << "% done." << std::endl;
 }
 
 
+/**
+ *  @brief  Seeding strategy and its parameters given by the program options.
+ */
+  inline SeedingParams
+seeding_params( const Options& options )
+{
+  SeedingParams params;
+  params.strategy = options.strategy;
+  params.seed_len = options.seed_len;
+  params.distance = options.distance;
+  params.window = options.window;
+  params.smer_len = options.smer_len;
+  params.max_seed_len = options.max_seed_len;
+  params.target_count = options.target_count;
+  return params;
+}
+
+
+/**
+ *  @brief  Flush an output and check that all of it is written to the file.
+ */
+  inline void
+sync_output( AnyWriter& writer, std::ofstream& output_file,
+    const std::string& output_filename )
+{
+  writer.flush();
+  output_file.flush();
+  if ( !output_file ) {
+    throw std::runtime_error( "could not write file '" + output_filename + "'" );
+  }
+}
+
+
+/**
+ *  @brief  Describe the options and the input determining the output of a run.
+ *
+ *  Used to check that a checkpoint belongs to the run being resumed.
+ */
+  inline std::string
+describe_run( const Options& options, std::size_t nof_patterns )
+{
+  std::string gcsa_filenames;
+  for ( const auto& gcsa_filename : options.gcsa_filenames ) {
+    gcsa_filenames += gcsa_filename + ",";
+  }
+  return "sequences=" + options.seq_filename + ";gcsa=" + gcsa_filenames
+    + "seed_len=" + std::to_string( options.seed_len )
+    + ";distance=" + std::to_string( options.distance )
+    + ";strategy=" + options.strategy
+    + ";window=" + std::to_string( options.window )
+    + ";smer_len=" + std::to_string( options.smer_len )
+    + ";max_seed_len=" + std::to_string( options.max_seed_len )
+    + ";target_count=" + std::to_string( options.target_count ) + ";shard=" + options.shard
+    + ";output_format=" + options.output_format
+    + ";chunk_size=" + std::to_string( options.chunk_size )
+    + ";patterns=" + std::to_string( nof_patterns );
+}
+
+
   void
-locate_seeds( std::string& seq_name, std::string& gcsa_name, unsigned int seed_len,
-    unsigned int distance, std::string& /* output_name */ )
+locate_seeds( const Options& options )
 {
-  //std::ofstream output_file( output_name, std::ofstream::out );
-  std::ifstream seq_file( seq_name, std::ifstream::in | std::ifstream::binary );
+  std::ifstream seq_file( options.seq_filename, std::ifstream::in | std::ifstream::binary );
   if ( !seq_file ) {
-    throw std::runtime_error("could not open file '" + seq_name + "'" );
+    throw std::runtime_error("could not open file '" + options.seq_filename + "'" );
   }
-  std::ifstream gcsa_file( gcsa_name, std::ifstream::in | std::ifstream::binary );
-  if ( !gcsa_file ) {
-    throw std::runtime_error("could not open file '" + gcsa_name + "'" );
+  std::vector< std::ifstream > gcsa_files;
+  for ( const auto& gcsa_filename : options.gcsa_filenames ) {
+    gcsa_files.emplace_back( gcsa_filename, std::ifstream::in | std::ifstream::binary );
+    if ( !gcsa_files.back() ) {
+      throw std::runtime_error("could not open file '" + gcsa_filename + "'" );
+    }
   }
-  gcsa::GCSA index;
+  std::vector< Locator > locators( gcsa_files.size() );
   std::vector< std::string > sequences;
   std::vector< std::string > patterns;
-  std::vector< gcsa::node_type > results;
+  unsigned int seed_len = 0;
+  Stats stats;
+  typedef Timer< SteadyClock > timer_type;
+
+  omp_set_num_threads( options.threads );
 
   std::cout << "Loading GCSA index..." << std::endl;
-  index.load( gcsa_file );
+  {
+    auto timer = timer_type( "index" );
+    /* Indexes are loaded concurrently, each by its own thread. */
+    std::vector< std::exception_ptr > errors( locators.size() );
+    std::vector< std::thread > loaders;
+    for ( std::size_t j = 0; j < locators.size(); ++j ) {
+      loaders.emplace_back( [&, j]( ) {
+          try {
+            locators[ j ].load( gcsa_files[ j ] );
+          }
+          catch ( ... ) {
+            errors[ j ] = std::current_exception();
+          }
+          } );
+    }
+    for ( auto& loader : loaders ) loader.join();
+    for ( const auto& error : errors ) {
+      if ( error ) std::rethrow_exception( error );
+    }
+  }
+  std::cout << "Loaded " << locators.size() << " GCSA index(es) in "
+            << timer_type::get_duration_str( "index" ) << "." << std::endl;
   std::cout << "Loading sequences..." << std::endl;
+  Shard shard = Shard::parse( options.shard );
   {
-    auto timer = Timer<>( "sequences" );
-    std::string line;
-    while ( std::getline( seq_file, line ) ) {
-      sequences.push_back( line );
+    auto timer = timer_type( "sequences" );
+    if ( shard.count != 1 ) {
+      shard.read_lines( sequences, seq_file );
+    }
+    else {
+      std::string line;
+      while ( std::getline( seq_file, line ) ) {
+        sequences.push_back( line );
+      }
     }
   }
   std::cout << "Loaded " << sequences.size() << " sequences in "
-            << Timer<>::get_duration_str( "sequences" ) << "." << std::endl;
+            << timer_type::get_duration_str( "sequences" ) << "." << std::endl;
+  if ( options.soak != 0 ) {
+    soak( locators, sequences, options, stats );
+    for ( const auto& phase : { "index", "sequences" } ) {
+      stats.set_phase( phase, timer_type::get_duration_rep( phase ) );
+    }
+    write_stats( stats, options );
+    return;
+  }
   std::cout << "Generating patterns..." << std::endl;
   {
-    auto timer = Timer<>( "patterns" );
-    seeding( patterns, sequences, seed_len, distance );
+    auto timer = timer_type( "patterns" );
+    seed_len = make_seeds( patterns, sequences, seeding_params( options ), locators );
   }
   ::total_no = patterns.size();
   std::cout << "Generated " << patterns.size() << " patterns in "
-            << Timer<>::get_duration_str( "patterns" ) << "." << std::endl;
+            << timer_type::get_duration_str( "patterns" ) << "." << std::endl;
+  std::size_t nof_short = count_short( sequences, options.seed_len );
+  if ( nof_short != 0 ) {
+    std::cout << "Skipped " << nof_short << " sequences shorter than the seed length."
+              << std::endl;
+  }
+  stats.set_counter( "short_sequences", nof_short );
+  /* Occurrences in the j-th index are written to the j-th output. */
+  std::vector< std::string > output_filenames;
+  for ( std::size_t j = 0; j < locators.size(); ++j ) {
+    output_filenames.push_back( locators.size() == 1 ? options.output_filename
+        : options.output_filename + "." + std::to_string( j ) );
+  }
+  if ( shard.count != 1 ) {
+    shard.patterns = patterns.size();
+    for ( const auto& output_filename : output_filenames ) shard.save( output_filename );
+  }
+  if ( options.workers != 0 ) {
+    fan_out( locators, patterns, output_filenames, options, stats );
+    stats.set_counter( "sequences", sequences.size() );
+    stats.set_counter( "patterns", patterns.size() );
+    write_stats( stats, options );
+    return;
+  }
+  /* Indexes before `resumed.index` are done, and so are the first `resumed.done`
+   * found patterns of index `resumed.index`. */
+  Checkpoint checkpoint;
+  checkpoint.run = describe_run( options, patterns.size() );
+  Checkpoint resumed = checkpoint;
+  if ( options.resume ) {
+    if ( !resumed.load( options.output_filename ) ) {
+      std::cout << "No checkpoint found; starting from the beginning." << std::endl;
+    }
+    else if ( resumed.run != checkpoint.run ) {
+      throw std::runtime_error( "checkpoint of '" + options.output_filename
+          + "' was written by a run with different options or input" );
+    }
+    else {
+      std::cout << "Resuming from index " << resumed.index << " after "
+                << resumed.done << " found patterns and " << resumed.occurrences
+                << " occurrences." << std::endl;
+    }
+  }
   std::cout << "Locating patterns..." << std::endl;
-  std::vector< gcsa::range_type > ranges;
-  gcsa::size_type total = 0;
+  Pipeline pipeline( locators, options.chunk_size );
   {
-    auto timer = Timer<>( "find" );
-    for ( const auto& p : patterns ) {
-      gcsa::range_type range = index.find( p );
-      if( !gcsa::Range::empty( range ) ) {
-        ranges.push_back( range );
-        total += index.count( range );
+    auto timer = timer_type( "find" );
+    pipeline.find( patterns, seed_len, resumed.index );
+  }
+  ::total_no = pipeline.get_nof_found();
+  std::cout << "Found " << pipeline.get_nof_found() << " patterns matching "
+            << pipeline.get_paths() << " paths in "
+            << timer_type::get_duration_str( "find" ) << "." << std::endl;
+  std::vector< std::ofstream > output_files;
+  std::vector< std::unique_ptr< AnyWriter > > writers;
+  output_files.resize( output_filenames.size() );
+  writers.resize( output_filenames.size() );
+  for ( std::size_t j = resumed.index; j < output_filenames.size(); ++j ) {
+    const auto& output_filename = output_filenames[ j ];
+    auto mode = std::ofstream::out | std::ofstream::binary;
+    std::uint64_t offset = 0;
+    if ( j == resumed.index && resumed.offset != 0 ) {
+      /* Drop the output written after the checkpoint and continue from there. */
+      if ( truncate( output_filename.c_str(), resumed.offset ) != 0 ) {
+        throw std::runtime_error( "could not truncate file '" + output_filename + "'" );
       }
+      mode |= std::ofstream::app;
+      offset = resumed.offset;
     }
+    output_files[ j ].open( output_filename, mode );
+    if ( !output_files[ j ] ) {
+      throw std::runtime_error("could not open file '" + output_filename + "'" );
+    }
+    writers[ j ].reset( new AnyWriter( output_files[ j ], options.output_format,
+          options.compression_level, offset ) );
   }
-  std::cout << "Found " << ranges.size() << " patterns matching " << total << " paths in "
-            << Timer<>::get_duration_str( "find" ) << "." << std::endl;
-  total = 0;
+  std::size_t occs = 0;
+  std::uint64_t output_bytes = 0;
+  auto last_checkpoint = SteadyClock::now();
+  ::done_idx = resumed.done;
   {
-    auto timer = Timer<>( "locate" );
-    for ( const auto& range : ranges ) {
-      index.locate( range, results );
-      // TODO: In order to be fair comparison, results should be written to file using async IO.
-      ::total_occs += results.size();
-      ::done_idx++;
+    auto timer = timer_type( "locate" );
+    for ( std::size_t j = resumed.index; j < locators.size(); ++j ) {
+      auto& writer = *writers[ j ];
+      std::size_t done = j == resumed.index ? resumed.done : 0;
+      pipeline.locate( j, writer, done, [&]( std::size_t last, std::size_t batch_occs ) {
+          occs += batch_occs;
+          ::total_occs += batch_occs;
+          ::done_idx += last - done;
+          done = last;
+          if ( options.checkpoint == 0 || SteadyClock::now() - last_checkpoint
+              < std::chrono::seconds( options.checkpoint ) ) {
+            return;
+          }
+          /* The checkpoint must not cover output which did not reach the file. */
+          sync_output( writer, output_files[ j ], output_filenames[ j ] );
+          checkpoint.index = j;
+          checkpoint.done = last;
+          checkpoint.offset = writer.bytes_written();
+          checkpoint.occurrences = resumed.occurrences + occs;
+          checkpoint.save( options.output_filename );
+          last_checkpoint = SteadyClock::now();
+          } );
+      if ( !writer.close() ) {
+        throw std::runtime_error( "could not write file '" + output_filenames[ j ] + "'" );
+      }
+      output_bytes += writer.bytes_written();
     }
   }
-  std::cout << "Located " << ::total_occs << " occurrences in "
-            << Timer<>::get_duration_str( "locate" ) << "." << std::endl;
+  if ( options.checkpoint != 0 ) {
+    checkpoint.index = locators.size();
+    checkpoint.done = 0;
+    checkpoint.offset = 0;
+    checkpoint.occurrences = resumed.occurrences + occs;
+    checkpoint.save( options.output_filename );
+  }
+  std::cout << "Located " << occs << " occurrences in "
+            << timer_type::get_duration_str( "locate" ) << "." << std::endl;
+
+  for ( const auto& phase : { "index", "sequences", "patterns", "find" } ) {
+    stats.set_phase( phase, timer_type::get_duration_rep( phase ) );
+  }
+  /* Writing is timed within the locate loop; the phases are kept disjoint. */
+  auto output_usecs = std::chrono::duration_cast< std::chrono::microseconds >(
+      pipeline.get_output_time() ).count();
+  stats.set_phase( "locate", timer_type::get_duration_rep( "locate" ) - output_usecs );
+  stats.set_phase( "output", output_usecs );
+  stats.set_counter( "sequences", sequences.size() );
+  stats.set_counter( "patterns", patterns.size() );
+  stats.set_counter( "found", pipeline.get_nof_found() );
+  stats.set_counter( "paths", pipeline.get_paths() );
+  stats.set_counter( "occurrences", occs );
+  stats.set_counter( "output_bytes", output_bytes );
+  write_stats( stats, options );
+}
+
+
+/**
+ *  @brief  Replay the sequences in a loop for a fixed duration.
+ *
+ *  All threads repeatedly take the next chunk of sequences (wrapping around at the
+ *  end), extract their seeds and locate them in all indexes until `options.soak`
+ *  seconds are elapsed; occurrences are counted but not written. Every
+ *  `options.soak_interval` seconds the throughput of the last interval and the
+ *  current resident set size are reported, so that leaks, allocator fragmentation and
+ *  throughput decay of long runs show up as trends.
+ */
+  void
+soak( const std::vector< Locator >& locators,
+    const std::vector< std::string >& sequences, const Options& options, Stats& stats )
+{
+  if ( sequences.empty() ) throw std::runtime_error( "no sequences to replay" );
+  SeedingParams params = seeding_params( options );
+  std::atomic< std::size_t > next( 0 );
+  std::atomic< bool > stop( false );
+  std::atomic< std::uint64_t > nof_reads( 0 );
+  std::atomic< std::uint64_t > nof_seeds( 0 );
+  std::atomic< std::uint64_t > nof_occs( 0 );
+  std::uint64_t intervals = 0;
+  double first_rate = 0;
+  double last_rate = 0;
+  long long int first_rss = 0;
+  long long int last_rss = 0;
+
+  std::cout << "Soaking for " << options.soak << " seconds..." << std::endl;
+  auto start = SteadyClock::now();
+  auto deadline = start + std::chrono::seconds( options.soak );
+#pragma omp parallel
+  {
+    std::vector< std::string > chunk;
+    std::vector< std::string > patterns;
+    Hits hits;
+    auto last = start;
+    std::uint64_t last_reads = 0;
+    std::uint64_t last_seeds = 0;
+    std::uint64_t last_occs = 0;
+    while ( !stop.load( std::memory_order_relaxed ) ) {
+      std::size_t first = next.fetch_add( SOAK_CHUNK_SIZE ) % sequences.size();
+      chunk.assign( sequences.begin() + first,
+          sequences.begin() + std::min( first + SOAK_CHUNK_SIZE, sequences.size() ) );
+      patterns.clear();
+      make_seeds( patterns, chunk, params, locators );
+      for ( const auto& locator : locators ) {
+        locator.locate( patterns.begin(), patterns.end(), hits );
+        nof_occs += hits.nodes.size();
+      }
+      nof_reads += chunk.size();
+      nof_seeds += patterns.size();
+
+      if ( omp_get_thread_num() != 0 ) continue;
+      auto now = SteadyClock::now();
+      if ( now - last < std::chrono::seconds( options.soak_interval ) && now < deadline ) {
+        continue;
+      }
+      double secs = std::chrono::duration< double >( now - last ).count();
+      std::uint64_t reads = nof_reads;
+      std::uint64_t seeds = nof_seeds;
+      std::uint64_t total = nof_occs;
+      last_rate = ( reads - last_reads ) / secs;
+      last_rss = Stats::current_rss();
+      if ( intervals++ == 0 ) {
+        first_rate = last_rate;
+        first_rss = last_rss;
+      }
+      std::cout << "[" << std::chrono::duration_cast< std::chrono::seconds >(
+          now - start ).count() << "s] "
+                << static_cast< std::uint64_t >( last_rate ) << " reads/s, "
+                << static_cast< std::uint64_t >( ( seeds - last_seeds ) / secs )
+                << " seeds/s, "
+                << static_cast< std::uint64_t >( ( total - last_occs ) / secs )
+                << " occurrences/s, RSS " << last_rss << " kB" << std::endl;
+      last = now;
+      last_reads = reads;
+      last_seeds = seeds;
+      last_occs = total;
+      if ( now >= deadline ) stop = true;
+    }
+  }
+  std::cout << "Replayed " << nof_reads << " sequences with " << nof_seeds
+            << " seeds and " << nof_occs << " occurrences in " << intervals
+            << " intervals." << std::endl;
+
+  stats.set_counter( "sequences", nof_reads );
+  stats.set_counter( "patterns", nof_seeds );
+  stats.set_counter( "occurrences", nof_occs );
+  stats.set_counter( "soak_intervals", intervals );
+  stats.set_counter( "first_interval_reads_per_s", static_cast< long long int >( first_rate ) );
+  stats.set_counter( "last_interval_reads_per_s", static_cast< long long int >( last_rate ) );
+  stats.set_counter( "first_interval_rss_kb", first_rss );
+  stats.set_counter( "last_interval_rss_kb", last_rss );
+}
+
+
+/**
+ *  @brief  Locate the patterns by forked worker processes (see `Coordinator`).
+ */
+  void
+fan_out( const std::vector< Locator >& locators, const std::vector< std::string >& patterns,
+    const std::vector< std::string >& output_filenames, const Options& options,
+    Stats& stats )
+{
+  typedef Timer< SteadyClock > timer_type;
+  std::vector< std::ofstream > output_files( output_filenames.size() );
+  std::vector< std::unique_ptr< AnyWriter > > writers;
+  for ( std::size_t j = 0; j < output_filenames.size(); ++j ) {
+    output_files[ j ].open( output_filenames[ j ], std::ofstream::out | std::ofstream::binary );
+    if ( !output_files[ j ] ) {
+      throw std::runtime_error("could not open file '" + output_filenames[ j ] + "'" );
+    }
+    writers.emplace_back( new AnyWriter( output_files[ j ], options.output_format,
+          options.compression_level ) );
+  }
+  std::cout << "Locating patterns by " << options.workers << " workers..." << std::endl;
+  Coordinator coordinator( locators, patterns, options.workers, Pipeline::BATCH_SIZE );
+  std::uint64_t output_bytes = 0;
+  {
+    auto timer = timer_type( "locate" );
+    coordinator.run( writers );
+    for ( std::size_t j = 0; j < writers.size(); ++j ) {
+      if ( !writers[ j ]->close() ) {
+        throw std::runtime_error( "could not write file '" + output_filenames[ j ] + "'" );
+      }
+      output_bytes += writers[ j ]->bytes_written();
+    }
+  }
+  std::cout << "Found " << coordinator.get_found() << " patterns matching "
+            << coordinator.get_paths() << " paths with "
+            << coordinator.get_occurrences() << " occurrences in "
+            << timer_type::get_duration_str( "locate" ) << "." << std::endl;
+
+  for ( const auto& phase : { "index", "sequences", "patterns", "locate" } ) {
+    stats.set_phase( phase, timer_type::get_duration_rep( phase ) );
+  }
+  stats.set_counter( "found", coordinator.get_found() );
+  stats.set_counter( "paths", coordinator.get_paths() );
+  stats.set_counter( "occurrences", coordinator.get_occurrences() );
+  stats.set_counter( "output_bytes", output_bytes );
+  stats.set_counter( "worker_restarts", coordinator.get_restarts() );
+}
+
+
+/**
+ *  @brief  Write the statistics of the run to the stats file if requested.
+ */
+  void
+write_stats( Stats& stats, const Options& options )
+{
+  if ( options.stats_filename.empty() ) return;
+
+  stats.set_context( "version", release::version );
+  stats.set_context( "sequences", options.seq_filename );
+  std::string gcsa_filenames;
+  for ( const auto& gcsa_filename : options.gcsa_filenames ) {
+    if ( !gcsa_filenames.empty() ) gcsa_filenames += ",";
+    gcsa_filenames += gcsa_filename;
+  }
+  stats.set_context( "gcsa", gcsa_filenames );
+  stats.set_context( "seed_len", options.seed_len );
+  stats.set_context( "distance", options.distance );
+  stats.set_context( "strategy", options.strategy );
+  if ( options.strategy == "minimizer" ) stats.set_context( "window", options.window );
+  if ( options.strategy == "open-syncmer" || options.strategy == "closed-syncmer" ) {
+    stats.set_context( "smer_len", options.smer_len );
+  }
+  if ( options.strategy == "adaptive" ) {
+    stats.set_context( "max_seed_len", options.max_seed_len );
+    stats.set_context( "target_count", options.target_count );
+  }
+  stats.set_context( "threads", options.threads );
+  stats.set_context( "output_format", options.output_format );
+  stats.set_context( "chunk_size", options.chunk_size );
+  stats.set_context( "shard", options.shard );
+  stats.set_context( "checkpoint", options.checkpoint );
+  stats.set_context( "resume", options.resume );
+  stats.set_context( "workers", options.workers );
+  if ( options.soak != 0 ) {
+    stats.set_context( "soak", options.soak );
+    stats.set_context( "soak_interval", options.soak_interval );
+  }
+  stats.set_counter( "max_rss_kb", Stats::max_rss() );
+  std::ofstream stats_file( options.stats_filename, std::ofstream::out );
+  if ( !stats_file ) {
+    throw std::runtime_error("could not open file '" + options.stats_filename + "'" );
+  }
+  stats.to_json( stats_file );
 }
 
 
@@ -187,13 +611,16 @@ setup_argparser( seqan::ArgumentParser& parser )
   seqan::ArgParseArgument seq_arg( seqan::ArgParseArgument::INPUT_FILE, POSARG1 );
   addArgument( parser, seq_arg );
   // GCSA2 index file -- **required** option.
-  seqan::ArgParseOption gcsa_arg( "g", "gcsa", "GCSA2 index file.",
-      seqan::ArgParseArgument::INPUT_FILE, "GCSA2_FILE" );
+  seqan::ArgParseOption gcsa_arg( "g", "gcsa", "GCSA2 index file; may be given more "
+      "than once, e.g. for per-chromosome indexes, in which case the occurrences in the "
+      "j-th index are written to OUTPUT.j (zero-based).",
+      seqan::ArgParseArgument::INPUT_FILE, "GCSA2_FILE", true );
   setValidValues( gcsa_arg, gcsa::GCSA::EXTENSION );
   addOption( parser, gcsa_arg );
   setRequired( parser, "g" );
   // Seed length.
-  addOption( parser, seqan::ArgParseOption( "l", "seed-len", "Seed length.",
+  addOption( parser, seqan::ArgParseOption( "l", "seed-len",
+        "Seed length; the minimum seed length of the \\fIadaptive\\fP strategy.",
         seqan::ArgParseArgument::INTEGER, "INT" ) );
   setRequired( parser, "l" );
   // Overlapping seeds?
@@ -201,12 +628,116 @@ setup_argparser( seqan::ArgumentParser& parser )
         "Distance between seeds [default: seed length given by \\fB-l\\fP]",
         seqan::ArgParseArgument::INTEGER, "INT" ) );
   setDefaultValue( parser, "d", 0 );  /* Default value is seed length. */
+  // Seeding strategy.
+  addOption( parser, seqan::ArgParseOption( "s", "strategy",
+        "Seeding strategy; \\fIstep\\fP extracts seeds with distance given by \\fB-d\\fP.",
+        seqan::ArgParseArgument::STRING, "STR" ) );
+  setValidValues( parser, "s",
+      "step greedy-overlapping non-overlapping greedy-non-overlapping minimizer "
+      "open-syncmer closed-syncmer adaptive" );
+  setDefaultValue( parser, "s", "step" );
+  // Window of minimizers.
+  addOption( parser, seqan::ArgParseOption( "", "window",
+        "Number of consecutive k-mers in a window of the \\fIminimizer\\fP strategy, "
+        "which selects the k-mer of the smallest hash in each window.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "window", "1" );
+  setDefaultValue( parser, "window", 10 );
+  // Length of the s-mers of syncmers.
+  addOption( parser, seqan::ArgParseOption( "", "smer-len",
+        "Length of the s-mers of the \\fIopen-syncmer\\fP and \\fIclosed-syncmer\\fP "
+        "strategies, which select the k-mers whose smallest s-mer is in the middle, "
+        "or at the start or the end, respectively.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "smer-len", "1" );
+  setDefaultValue( parser, "smer-len", 8 );
+  // Adaptive seed length.
+  addOption( parser, seqan::ArgParseOption( "", "max-seed-len",
+        "Maximum seed length of the \\fIadaptive\\fP strategy, which extends the seeds "
+        "ending every \\fB-d\\fP bases past \\fB-l\\fP bases while they have more "
+        "than \\fB--target-count\\fP occurrences in any index "
+        "[default: twice the seed length].",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "max-seed-len", 0 );  /* Default value is twice seed length. */
+  addOption( parser, seqan::ArgParseOption( "", "target-count",
+        "Number of occurrences below which the seeds of the \\fIadaptive\\fP strategy "
+        "are not extended further.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "target-count", "1" );
+  setDefaultValue( parser, "target-count", 64 );
+  // Number of threads.
+  addOption( parser, seqan::ArgParseOption( "t", "threads", "Number of threads.",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "t", "1" );
+  setDefaultValue( parser, "t", 1 );
+  // Statistics file.
+  addOption( parser, seqan::ArgParseOption( "S", "stats",
+        "Write timings and counters of the run in JSON format.",
+        seqan::ArgParseArgument::OUTPUT_FILE, "STATS" ) );
   // Output file.
   seqan::ArgParseOption output_arg( "o", "output",
       "Write positions where sequences are matched.",
       seqan::ArgParseArgument::OUTPUT_FILE, "OUTPUT" );
   addOption( parser, output_arg );
   setRequired( parser, "o" );
+  // Output format.
+  addOption( parser, seqan::ArgParseOption( "O", "output-format",
+        "Output format; \\fItsv\\fP writes seed index, node id, offset and strand "
+        "per line, \\fIbinary\\fP writes (seed index, node) 64-bit pairs, and "
+        "\\fIcompressed\\fP writes zlib-compressed blocks of binary records.",
+        seqan::ArgParseArgument::STRING, "FORMAT" ) );
+  setValidValues( parser, "O", "tsv binary compressed" );
+  setDefaultValue( parser, "O", "tsv" );
+  // Compression level.
+  addOption( parser, seqan::ArgParseOption( "z", "compression-level",
+        "Compression level of \\fIcompressed\\fP output format (1-9).",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "z", "1" );
+  setMaxValue( parser, "z", "9" );
+  setDefaultValue( parser, "z", 6 );
+  // Chunked locate.
+  addOption( parser, seqan::ArgParseOption( "c", "chunk-size",
+        "Locate patterns matching more than INT paths incrementally and write their "
+        "occurrences in chunks of at most INT as they are located; 0 locates every "
+        "pattern at once. The same occurrences are written either way, each once, but "
+        "split into several records.", seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "c", 0 );
+  // Checkpointing.
+  addOption( parser, seqan::ArgParseOption( "", "checkpoint",
+        "Write a checkpoint to OUTPUT.ckpt every SECS seconds, at the end of the "
+        "batch of patterns being written, and when the run finishes; 0 disables "
+        "checkpoints.", seqan::ArgParseArgument::INTEGER, "SECS" ) );
+  setDefaultValue( parser, "checkpoint", 0 );
+  addOption( parser, seqan::ArgParseOption( "", "resume",
+        "Resume an interrupted run with the same options from its last checkpoint: "
+        "the output written after the checkpoint is dropped and the remaining "
+        "patterns are located. Without a checkpoint, the run starts from the "
+        "beginning." ) );
+  // Multi-process fan-out.
+  addOption( parser, seqan::ArgParseOption( "w", "workers",
+        "Locate the patterns by INT forked single-threaded worker processes sharing "
+        "the loaded index, instead of by threads; 0 uses threads. Not supported with "
+        "\\fB--chunk-size\\fP, \\fB--checkpoint\\fP, \\fB--resume\\fP and "
+        "\\fB--soak\\fP.", seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setDefaultValue( parser, "w", 0 );
+  // Input sharding.
+  addOption( parser, seqan::ArgParseOption( "", "shard",
+        "Process only the lines starting in the INDEX-th of COUNT equal byte ranges of "
+        "the sequence file (zero-based); the shard is recorded in OUTPUT.shard so that "
+        "the outputs can be merged by \\fBgcsa_merge\\fP.",
+        seqan::ArgParseArgument::STRING, "INDEX/COUNT" ) );
+  setDefaultValue( parser, "shard", "0/1" );
+  // Soak mode.
+  addOption( parser, seqan::ArgParseOption( "", "soak",
+        "Replay the sequences in a loop for the given number of seconds with all "
+        "threads busy, reporting throughput and resident set size periodically; "
+        "occurrences are not written.", seqan::ArgParseArgument::INTEGER, "SECS" ) );
+  setDefaultValue( parser, "soak", 0 );
+  addOption( parser, seqan::ArgParseOption( "", "soak-interval",
+        "Reporting interval of \\fB--soak\\fP in seconds.",
+        seqan::ArgParseArgument::INTEGER, "SECS" ) );
+  setMinValue( parser, "soak-interval", "1" );
+  setDefaultValue( parser, "soak-interval", 10 );
 }
 
 
@@ -214,9 +745,41 @@ setup_argparser( seqan::ArgumentParser& parser )
 get_option_values( Options& options, seqan::ArgumentParser& parser )
 {
   getArgumentValue( options.seq_filename, parser, 0 );
-  getOptionValue( options.gcsa_filename, parser, "gcsa" );
+  options.gcsa_filenames.resize( getOptionValueCount( parser, "gcsa" ) );
+  for ( std::size_t j = 0; j < options.gcsa_filenames.size(); ++j ) {
+    getOptionValue( options.gcsa_filenames[ j ], parser, "gcsa", j );
+  }
   getOptionValue( options.output_filename, parser, "output" );
   getOptionValue( options.seed_len, parser, "seed-len" );
   getOptionValue( options.distance, parser, "distance" );
   if ( options.distance == 0 ) options.distance = options.seed_len;
+  getOptionValue( options.strategy, parser, "strategy" );
+  getOptionValue( options.window, parser, "window" );
+  getOptionValue( options.smer_len, parser, "smer-len" );
+  getOptionValue( options.max_seed_len, parser, "max-seed-len" );
+  if ( options.max_seed_len == 0 ) options.max_seed_len = 2 * options.seed_len;
+  if ( options.strategy == "adaptive" && options.max_seed_len < options.seed_len ) {
+    throw std::runtime_error( "--max-seed-len cannot be smaller than --seed-len" );
+  }
+  getOptionValue( options.target_count, parser, "target-count" );
+  if ( ( options.strategy == "open-syncmer" || options.strategy == "closed-syncmer" )
+      && options.smer_len > options.seed_len ) {
+    throw std::runtime_error( "--smer-len cannot be larger than --seed-len" );
+  }
+  getOptionValue( options.threads, parser, "threads" );
+  getOptionValue( options.stats_filename, parser, "stats" );
+  getOptionValue( options.output_format, parser, "output-format" );
+  getOptionValue( options.compression_level, parser, "compression-level" );
+  getOptionValue( options.chunk_size, parser, "chunk-size" );
+  getOptionValue( options.shard, parser, "shard" );
+  getOptionValue( options.checkpoint, parser, "checkpoint" );
+  options.resume = isSet( parser, "resume" );
+  getOptionValue( options.workers, parser, "workers" );
+  getOptionValue( options.soak, parser, "soak" );
+  getOptionValue( options.soak_interval, parser, "soak-interval" );
+  if ( options.workers != 0 && ( options.chunk_size != 0 || options.checkpoint != 0
+        || options.resume || options.soak != 0 ) ) {
+    throw std::runtime_error( "--workers cannot be used with --chunk-size, "
+        "--checkpoint, --resume or --soak" );
+  }
 }
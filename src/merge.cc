@@ -0,0 +1,230 @@
+/**
+ *    @file  merge.cc
+ *   @brief  gcsa_merge main program.
+ *
+ *  Merges the outputs of sharded `gcsa_locate` runs into the output of a single run.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  12:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+#include <string>
+
+#include <seqan/arg_parse.h>
+
+#include <config.h>
+#include "shard.h"
+#include "output.h"
+#include "release.h"
+
+
+typedef struct {
+  std::vector< std::string > input_filenames;
+  std::string output_filename;
+  std::string output_format;
+  int compression_level;
+} MergeOptions;
+
+/**
+ *  @brief  Output of a shard being merged.
+ */
+struct ShardInput {
+  Shard shard;
+  std::string filename;
+  std::uint64_t base;       /**< @brief Seed identifier of its first pattern in a single run. */
+  std::unique_ptr< std::ifstream > in;
+  std::unique_ptr< AnyReader > reader;
+  std::uint64_t seed;       /**< @brief Current record, in seed identifiers of a single run. */
+  std::uint64_t node;
+
+  /**
+   *  @brief  Read the next record; false at the end of the shard output.
+   */
+    inline bool
+  next( )
+  {
+    std::uint64_t last = this->seed;
+    if ( !this->reader->next( this->seed, this->node ) ) return false;
+    if ( this->seed >= this->shard.patterns ) {
+      throw std::runtime_error( "seed " + std::to_string( this->seed ) + " of '"
+          + this->filename + "' exceeds the number of patterns of its shard" );
+    }
+    this->seed += this->base;
+    if ( this->seed < last ) {
+      throw std::runtime_error( "records of '" + this->filename + "' are not in order" );
+    }
+    return true;
+  }
+};
+
+
+  seqan::ArgumentParser::ParseResult
+parse_args( MergeOptions& options, int argc, char* argv[] );
+
+  void
+merge( const MergeOptions& options );
+
+
+  int
+main( int argc, char* argv[] )
+{
+  MergeOptions options;
+  auto res = parse_args( options, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK )
+    return res == seqan::ArgumentParser::PARSE_ERROR;
+
+  merge( options );
+
+  return EXIT_SUCCESS;
+}
+
+
+/**
+ *  @brief  Merge the shard outputs.
+ *
+ *  The inputs may be given in any order; all shards of the run must be present. The
+ *  records are k-way merged by their seed identifiers in a single run (the seed
+ *  identifiers of each shard shifted by the number of patterns of the preceding
+ *  shards), so that the output is the same as of a single run with the same
+ *  options.
+ */
+  void
+merge( const MergeOptions& options )
+{
+  std::vector< ShardInput > inputs( options.input_filenames.size() );
+  for ( std::size_t i = 0; i < inputs.size(); ++i ) {
+    auto& input = inputs[ i ];
+    input.filename = options.input_filenames[ i ];
+    input.shard = Shard::load( input.filename );
+    input.in.reset( new std::ifstream( input.filename,
+          std::ifstream::in | std::ifstream::binary ) );
+    if ( !*input.in ) {
+      throw std::runtime_error( "could not open file '" + input.filename + "'" );
+    }
+    input.reader.reset( new AnyReader( *input.in ) );
+  }
+  if ( inputs.empty() ) throw std::runtime_error( "no shard outputs given" );
+
+  /* Check that each shard is given exactly once and compute the bases. */
+  unsigned int count = inputs[ 0 ].shard.count;
+  std::vector< ShardInput* > by_index( count, nullptr );
+  for ( auto& input : inputs ) {
+    if ( input.shard.count != count ) {
+      throw std::runtime_error( "'" + input.filename + "' is a shard of a run with "
+          + std::to_string( input.shard.count ) + " shards; expected "
+          + std::to_string( count ) );
+    }
+    if ( by_index[ input.shard.index ] != nullptr ) {
+      throw std::runtime_error( "shard " + std::to_string( input.shard.index )
+          + " is given more than once" );
+    }
+    by_index[ input.shard.index ] = &input;
+  }
+  std::uint64_t base = 0;
+  for ( unsigned int i = 0; i < count; ++i ) {
+    if ( by_index[ i ] == nullptr ) {
+      throw std::runtime_error( "shard " + std::to_string( i ) + "/"
+          + std::to_string( count ) + " is missing" );
+    }
+    by_index[ i ]->base = base;
+    by_index[ i ]->seed = base;
+    base += by_index[ i ]->shard.patterns;
+  }
+
+  std::string format = options.output_format;
+  if ( format.empty() ) format = inputs[ 0 ].reader->format();
+  std::ofstream output_file( options.output_filename,
+      std::ofstream::out | std::ofstream::binary );
+  if ( !output_file ) {
+    throw std::runtime_error( "could not open file '" + options.output_filename + "'" );
+  }
+  AnyWriter writer( output_file, format, options.compression_level );
+
+  auto greater = []( const ShardInput* a, const ShardInput* b ) {
+    return a->seed > b->seed;
+  };
+  std::priority_queue< ShardInput*, std::vector< ShardInput* >, decltype( greater ) >
+    heap( greater );
+  for ( auto& input : inputs ) {
+    if ( input.next() ) heap.push( &input );
+  }
+  /* Occurrences of a seed are written at once as in a single run. */
+  std::uint64_t occs = 0;
+  std::vector< std::uint64_t > nodes;
+  while ( !heap.empty() ) {
+    ShardInput* input = heap.top();
+    heap.pop();
+    std::uint64_t seed = input->seed;
+    nodes.clear();
+    bool more;
+    do {
+      nodes.push_back( input->node );
+    } while ( ( more = input->next() ) && input->seed == seed );
+    writer.write( seed, nodes );
+    occs += nodes.size();
+    if ( more ) heap.push( input );
+  }
+  if ( !writer.close() ) {
+    throw std::runtime_error( "could not write file '" + options.output_filename + "'" );
+  }
+  std::cout << "Merged " << occs << " occurrences of " << base << " patterns from "
+            << count << " shards." << std::endl;
+}
+
+
+  inline seqan::ArgumentParser::ParseResult
+parse_args( MergeOptions& options, int argc, char* argv[] )
+{
+  seqan::ArgumentParser parser( "gcsa_merge" );
+  addUsageLine( parser, "[\\fIOPTIONS\\fP] \\fB-o\\fP \\fIOUTPUT\\fP "
+      "\"\\fISHARD_OUTPUT\\fP ...\"" );
+  setShortDescription( parser, "Merge sharded gcsa_locate outputs" );
+  setVersion( parser, release::version );
+  setDate( parser, LAST_MOD_DATE );
+  addDescription( parser, "Merge the outputs of gcsa_locate runs with \\fB--shard\\fP "
+      "INDEX/COUNT into the output of a single run over the whole input. The shard of "
+      "each output is read from the file of the same name with suffix .shard written "
+      "along with it." );
+  addArgument( parser, seqan::ArgParseArgument( seqan::ArgParseArgument::INPUT_FILE,
+        "SHARD_OUTPUT", true ) );
+  seqan::ArgParseOption output_arg( "o", "output", "Merged output file.",
+      seqan::ArgParseArgument::OUTPUT_FILE, "OUTPUT" );
+  addOption( parser, output_arg );
+  setRequired( parser, "o" );
+  addOption( parser, seqan::ArgParseOption( "O", "output-format",
+        "Output format [default: format of the shard outputs].",
+        seqan::ArgParseArgument::STRING, "FORMAT" ) );
+  setValidValues( parser, "O", "tsv binary compressed" );
+  addOption( parser, seqan::ArgParseOption( "z", "compression-level",
+        "Compression level of \\fIcompressed\\fP output format (1-9).",
+        seqan::ArgParseArgument::INTEGER, "INT" ) );
+  setMinValue( parser, "z", "1" );
+  setMaxValue( parser, "z", "9" );
+  setDefaultValue( parser, "z", 6 );
+
+  auto res = seqan::parse( parser, argc, argv );
+  if ( res != seqan::ArgumentParser::PARSE_OK ) return res;
+
+  options.input_filenames.resize( getArgumentValueCount( parser, 0 ) );
+  for ( std::size_t i = 0; i < options.input_filenames.size(); ++i ) {
+    getArgumentValue( options.input_filenames[ i ], parser, 0, i );
+  }
+  getOptionValue( options.output_filename, parser, "output" );
+  getOptionValue( options.output_format, parser, "output-format" );
+  getOptionValue( options.compression_level, parser, "compression-level" );
+  return seqan::ArgumentParser::PARSE_OK;
+}
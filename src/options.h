@@ -19,13 +19,30 @@
 #define OPTIONS_H__
 
 #include <string>
+#include <vector>
 
 typedef struct {
   std::string seq_filename;
-  std::string gcsa_filename;
+  std::vector< std::string > gcsa_filenames;
   std::string output_filename;
+  std::string stats_filename;
+  std::string strategy;
+  std::string output_format;
+  std::string shard;
   unsigned int seed_len;
   unsigned int distance;
+  unsigned int window;
+  unsigned int smer_len;
+  unsigned int max_seed_len;
+  unsigned int target_count;
+  unsigned int threads;
+  unsigned int chunk_size;
+  unsigned int checkpoint;
+  unsigned int workers;
+  unsigned int soak;
+  unsigned int soak_interval;
+  int compression_level;
+  bool resume;
 } Options;
 
 #endif  // OPTIONS_H__
@@ -0,0 +1,649 @@
+/**
+ *    @file  output.h
+ *   @brief  Output writers.
+ *
+ *  Writers for located seed occurrences in different formats.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  19:30
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef OUTPUT_H__
+#define OUTPUT_H__
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+
+/* Output formats */
+struct TsvFormat;
+struct BinaryFormat;
+struct CompressedFormat;
+
+/**
+ *  @brief  Node position codec of GCSA2 (`gcsa::Node`).
+ *
+ *  Duplicated here so that the writers do not depend on GCSA2 headers; the node
+ *  identifier is stored above the orientation bit and the 10-bit offset.
+ */
+struct NodeCodec {
+  constexpr static const std::uint64_t OFFSET_BITS = 10;
+  constexpr static const std::uint64_t ORIENTATION_MASK = 1 << OFFSET_BITS;
+  constexpr static const std::uint64_t OFFSET_MASK = ORIENTATION_MASK - 1;
+
+    static inline std::uint64_t
+  id( std::uint64_t node )
+  {
+    return node >> ( OFFSET_BITS + 1 );
+  }
+
+    static inline std::uint64_t
+  offset( std::uint64_t node )
+  {
+    return node & OFFSET_MASK;
+  }
+
+    static inline bool
+  rc( std::uint64_t node )
+  {
+    return node & ORIENTATION_MASK;
+  }
+
+    static inline std::uint64_t
+  encode( std::uint64_t id, std::uint64_t offset, bool rc )
+  {
+    return ( id << ( OFFSET_BITS + 1 ) ) | ( rc ? ORIENTATION_MASK : 0 ) | offset;
+  }
+};
+
+/**
+ *  @brief  Occurrence writer.
+ *
+ *  Occurrences are written per seed: `write( seed, nodes )` reports all nodes at
+ *  which the seed with identifier `seed` occurs. Writers buffer their output and
+ *  are not thread-safe. `close` flushes the output and reports whether it reached
+ *  the stream; the destructor flushes what it can but does not report errors.
+ *
+ *  A writer constructed with a non-zero `offset` continues an output of that many
+ *  bytes written (and flushed) by an earlier writer: the header is not written
+ *  again and `bytes_written` includes the earlier output.
+ */
+template< typename TFormat >
+  class Writer;
+
+/**
+ *  @brief  Tab-separated text writer.
+ *
+ *  Writes one line per occurrence: seed identifier, node identifier, offset in the
+ *  node and strand ('+' or '-').
+ */
+template< >
+  class Writer< TsvFormat >
+  {
+    public:
+      /* ====================  CONSTANTS     ======================================= */
+      constexpr static const std::size_t BUFFER_SIZE = 1 << 16;
+      /* ====================  LIFECYCLE     ======================================= */
+      Writer( std::ostream& o, std::uint64_t offset=0 ) : out( o ), nbytes( offset )
+      {
+        this->buffer.reserve( BUFFER_SIZE + 64 );
+      }
+
+      /**
+       *  @brief  Flush the output as far as possible; errors are ignored, call
+       *          `close` to have them reported.
+       */
+      ~Writer( )
+      {
+        try {
+          this->flush();
+        }
+        catch ( ... ) { }
+      }
+      /* ====================  ACCESSORS     ======================================= */
+        inline std::uint64_t
+      bytes_written( ) const
+      {
+        return this->nbytes + this->buffer.size();
+      }
+      /* ====================  METHODS       ======================================= */
+      template< typename TNodes >
+          inline void
+        write( std::uint64_t seed, const TNodes& nodes )
+        {
+          for ( const auto& node : nodes ) {
+            this->append( seed );
+            this->buffer += '\t';
+            this->append( NodeCodec::id( node ) );
+            this->buffer += '\t';
+            this->append( NodeCodec::offset( node ) );
+            this->buffer += NodeCodec::rc( node ) ? "\t-\n" : "\t+\n";
+            if ( this->buffer.size() >= BUFFER_SIZE ) this->flush();
+          }
+        }
+
+        inline void
+      flush( )
+      {
+        this->out.write( this->buffer.data(), this->buffer.size() );
+        this->nbytes += this->buffer.size();
+        this->buffer.clear();
+      }
+
+      /**
+       *  @brief  Flush the buffered records and the output stream.
+       *
+       *  @return false if the output stream failed, e.g. the device is full.
+       */
+        inline bool
+      close( )
+      {
+        this->flush();
+        this->out.flush();
+        return !this->out.fail();
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::ostream& out;
+      std::string buffer;
+      std::uint64_t nbytes;
+      /* ====================  METHODS       ======================================= */
+        inline void
+      append( std::uint64_t value )
+      {
+        char digits[ 20 ];
+        int len = 0;
+        do {
+          digits[ len++ ] = '0' + value % 10;
+          value /= 10;
+        } while ( value != 0 );
+        while ( len != 0 ) this->buffer += digits[ --len ];
+      }
+  };  /* -----  end of template class Writer  ----- */
+
+/**
+ *  @brief  Fixed-size binary record writer.
+ *
+ *  The output starts with the 8-byte magic "GLOCBIN1" followed by one record per
+ *  occurrence: the seed identifier and the node (`gcsa::node_type`), both as 64-bit
+ *  integers in host byte order.
+ */
+template< >
+  class Writer< BinaryFormat >
+  {
+    public:
+      /* ====================  CONSTANTS     ======================================= */
+      constexpr static const char* MAGIC = "GLOCBIN1";
+      constexpr static const std::size_t BUFFER_RECORDS = 1 << 13;
+      /* ====================  LIFECYCLE     ======================================= */
+      Writer( std::ostream& o, std::uint64_t offset=0 ) : out( o ), nbytes( offset )
+      {
+        if ( offset == 0 ) {
+          this->out.write( MAGIC, 8 );
+          this->nbytes += 8;
+        }
+        this->buffer.reserve( 2 * BUFFER_RECORDS );
+      }
+
+      /**
+       *  @brief  Flush the output as far as possible; errors are ignored, call
+       *          `close` to have them reported.
+       */
+      ~Writer( )
+      {
+        try {
+          this->flush();
+        }
+        catch ( ... ) { }
+      }
+      /* ====================  ACCESSORS     ======================================= */
+        inline std::uint64_t
+      bytes_written( ) const
+      {
+        return this->nbytes + this->buffer.size() * sizeof( std::uint64_t );
+      }
+      /* ====================  METHODS       ======================================= */
+      template< typename TNodes >
+          inline void
+        write( std::uint64_t seed, const TNodes& nodes )
+        {
+          for ( const auto& node : nodes ) {
+            this->buffer.push_back( seed );
+            this->buffer.push_back( node );
+            if ( this->buffer.size() >= 2 * BUFFER_RECORDS ) this->flush();
+          }
+        }
+
+        inline void
+      flush( )
+      {
+        std::size_t size = this->buffer.size() * sizeof( std::uint64_t );
+        this->out.write( reinterpret_cast< const char* >( this->buffer.data() ), size );
+        this->nbytes += size;
+        this->buffer.clear();
+      }
+
+      /**
+       *  @brief  Flush the buffered records and the output stream.
+       *
+       *  @return false if the output stream failed, e.g. the device is full.
+       */
+        inline bool
+      close( )
+      {
+        this->flush();
+        this->out.flush();
+        return !this->out.fail();
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::ostream& out;
+      std::vector< std::uint64_t > buffer;
+      std::uint64_t nbytes;
+  };  /* -----  end of template class Writer  ----- */
+
+/**
+ *  @brief  Block-compressed binary record writer.
+ *
+ *  The output starts with the 8-byte magic "GLOCBGZ1"; then the binary records (as
+ *  in `Writer< BinaryFormat >`) are written in blocks, each compressed separately by
+ *  zlib and preceded by its uncompressed and compressed sizes as 32-bit integers.
+ *  Blocks can thus be decompressed independently and in parallel.
+ */
+template< >
+  class Writer< CompressedFormat >
+  {
+    public:
+      /* ====================  CONSTANTS     ======================================= */
+      constexpr static const char* MAGIC = "GLOCBGZ1";
+      constexpr static const std::size_t BLOCK_RECORDS = 1 << 14;
+      /* ====================  LIFECYCLE     ======================================= */
+      Writer( std::ostream& o, int lvl=Z_DEFAULT_COMPRESSION, std::uint64_t offset=0 )
+        : out( o ), level( lvl ), nbytes( offset )
+      {
+        if ( offset == 0 ) {
+          this->out.write( MAGIC, 8 );
+          this->nbytes += 8;
+        }
+        this->buffer.reserve( 2 * BLOCK_RECORDS );
+        this->compressed.resize(
+            compressBound( 2 * BLOCK_RECORDS * sizeof( std::uint64_t ) ) );
+      }
+
+      /**
+       *  @brief  Flush the output as far as possible; errors are ignored, call
+       *          `close` to have them reported.
+       */
+      ~Writer( )
+      {
+        try {
+          this->flush();
+        }
+        catch ( ... ) { }
+      }
+      /* ====================  ACCESSORS     ======================================= */
+        inline std::uint64_t
+      bytes_written( ) const
+      {
+        return this->nbytes;
+      }
+      /* ====================  METHODS       ======================================= */
+      template< typename TNodes >
+          inline void
+        write( std::uint64_t seed, const TNodes& nodes )
+        {
+          for ( const auto& node : nodes ) {
+            this->buffer.push_back( seed );
+            this->buffer.push_back( node );
+            if ( this->buffer.size() >= 2 * BLOCK_RECORDS ) this->flush();
+          }
+        }
+
+        inline void
+      flush( )
+      {
+        if ( this->buffer.empty() ) return;
+        uLong size = this->buffer.size() * sizeof( std::uint64_t );
+        uLongf csize = this->compressed.size();
+        int ret = compress2( this->compressed.data(), &csize,
+            reinterpret_cast< const Bytef* >( this->buffer.data() ), size, this->level );
+        if ( ret != Z_OK ) {
+          throw std::runtime_error( "compression failed with zlib error "
+              + std::to_string( ret ) );
+        }
+        std::uint32_t sizes[ 2 ] = { static_cast< std::uint32_t >( size ),
+          static_cast< std::uint32_t >( csize ) };
+        this->out.write( reinterpret_cast< const char* >( sizes ), sizeof( sizes ) );
+        this->out.write( reinterpret_cast< const char* >( this->compressed.data() ), csize );
+        this->nbytes += sizeof( sizes ) + csize;
+        this->buffer.clear();
+      }
+
+      /**
+       *  @brief  Flush the buffered records and the output stream.
+       *
+       *  @return false if the output stream failed, e.g. the device is full.
+       */
+        inline bool
+      close( )
+      {
+        this->flush();
+        this->out.flush();
+        return !this->out.fail();
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::ostream& out;
+      int level;
+      std::vector< std::uint64_t > buffer;
+      std::vector< Bytef > compressed;
+      std::uint64_t nbytes;
+  };  /* -----  end of template class Writer  ----- */
+
+/**
+ *  @brief  Occurrence reader.
+ *
+ *  Reads back the output of `Writer< TFormat >` one record at a time:
+ *  `next( seed, node )` returns false at the end of the input.
+ */
+template< typename TFormat >
+  class Reader;
+
+/**
+ *  @brief  Tab-separated text reader.
+ */
+template< >
+  class Reader< TsvFormat >
+  {
+    public:
+      /* ====================  LIFECYCLE     ======================================= */
+      Reader( std::istream& i ) : in( i ) { }
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      next( std::uint64_t& seed, std::uint64_t& node )
+      {
+        if ( !std::getline( this->in, this->line ) ) return false;
+        std::size_t pos = 0;
+        seed = this->field( pos );
+        std::uint64_t id = this->field( pos );
+        std::uint64_t offset = this->field( pos );
+        if ( pos + 1 != this->line.size()
+            || ( this->line[ pos ] != '+' && this->line[ pos ] != '-' ) ) {
+          throw std::runtime_error( "malformed record '" + this->line + "'" );
+        }
+        node = NodeCodec::encode( id, offset, this->line[ pos ] == '-' );
+        return true;
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::istream& in;
+      std::string line;
+      /* ====================  METHODS       ======================================= */
+      /**
+       *  @brief  Parse the integer field starting at `pos` and skip its tab.
+       */
+        inline std::uint64_t
+      field( std::size_t& pos )
+      {
+        std::uint64_t value = 0;
+        std::size_t start = pos;
+        for ( ; pos < this->line.size() && this->line[ pos ] != '\t'; ++pos ) {
+          if ( this->line[ pos ] < '0' || this->line[ pos ] > '9' ) break;
+          value = value * 10 + ( this->line[ pos ] - '0' );
+        }
+        if ( pos == start || pos == this->line.size() || this->line[ pos ] != '\t' ) {
+          throw std::runtime_error( "malformed record '" + this->line + "'" );
+        }
+        ++pos;
+        return value;
+      }
+  };  /* -----  end of template class Reader  ----- */
+
+/**
+ *  @brief  Fixed-size binary record reader.
+ *
+ *  The magic is expected to be consumed by the caller (see `AnyReader`).
+ */
+template< >
+  class Reader< BinaryFormat >
+  {
+    public:
+      /* ====================  LIFECYCLE     ======================================= */
+      Reader( std::istream& i ) : in( i ), pos( 0 )
+      {
+        this->buffer.reserve( 2 * Writer< BinaryFormat >::BUFFER_RECORDS );
+      }
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      next( std::uint64_t& seed, std::uint64_t& node )
+      {
+        if ( this->pos == this->buffer.size() && !this->fill() ) return false;
+        seed = this->buffer[ this->pos++ ];
+        node = this->buffer[ this->pos++ ];
+        return true;
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::istream& in;
+      std::vector< std::uint64_t > buffer;
+      std::size_t pos;
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      fill( )
+      {
+        std::size_t record = 2 * sizeof( std::uint64_t );
+        this->buffer.resize( 2 * Writer< BinaryFormat >::BUFFER_RECORDS );
+        this->in.read( reinterpret_cast< char* >( this->buffer.data() ),
+            this->buffer.size() * sizeof( std::uint64_t ) );
+        std::size_t size = this->in.gcount();
+        if ( size % record != 0 ) throw std::runtime_error( "truncated binary record" );
+        this->buffer.resize( size / sizeof( std::uint64_t ) );
+        this->pos = 0;
+        return size != 0;
+      }
+  };  /* -----  end of template class Reader  ----- */
+
+/**
+ *  @brief  Block-compressed binary record reader.
+ *
+ *  The magic is expected to be consumed by the caller (see `AnyReader`).
+ */
+template< >
+  class Reader< CompressedFormat >
+  {
+    public:
+      /* ====================  LIFECYCLE     ======================================= */
+      Reader( std::istream& i ) : in( i ), pos( 0 ) { }
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      next( std::uint64_t& seed, std::uint64_t& node )
+      {
+        while ( this->pos == this->buffer.size() ) {
+          if ( !this->fill() ) return false;
+        }
+        seed = this->buffer[ this->pos++ ];
+        node = this->buffer[ this->pos++ ];
+        return true;
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      std::istream& in;
+      std::vector< std::uint64_t > buffer;
+      std::vector< Bytef > compressed;
+      std::size_t pos;
+      /* ====================  METHODS       ======================================= */
+        inline bool
+      fill( )
+      {
+        std::uint32_t sizes[ 2 ];
+        this->in.read( reinterpret_cast< char* >( sizes ), sizeof( sizes ) );
+        if ( this->in.gcount() == 0 ) return false;
+        if ( static_cast< std::size_t >( this->in.gcount() ) != sizeof( sizes )
+            || sizes[ 0 ] % ( 2 * sizeof( std::uint64_t ) ) != 0 ) {
+          throw std::runtime_error( "corrupted block header" );
+        }
+        this->compressed.resize( sizes[ 1 ] );
+        this->in.read( reinterpret_cast< char* >( this->compressed.data() ), sizes[ 1 ] );
+        if ( static_cast< std::size_t >( this->in.gcount() ) != sizes[ 1 ] ) {
+          throw std::runtime_error( "truncated compressed block" );
+        }
+        this->buffer.resize( sizes[ 0 ] / sizeof( std::uint64_t ) );
+        uLongf size = sizes[ 0 ];
+        int ret = uncompress( reinterpret_cast< Bytef* >( this->buffer.data() ), &size,
+            this->compressed.data(), sizes[ 1 ] );
+        if ( ret != Z_OK || size != sizes[ 0 ] ) {
+          throw std::runtime_error( "decompression failed with zlib error "
+              + std::to_string( ret ) );
+        }
+        this->pos = 0;
+        return true;
+      }
+  };  /* -----  end of template class Reader  ----- */
+
+/**
+ *  @brief  Writer of a format chosen at run time.
+ *
+ *  Dispatches to one of the writers above by a single switch per seed; the inner
+ *  loop over occurrences stays in the format-specific writer.
+ */
+class AnyWriter
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    /**
+     *  @brief  Create a writer by format name.
+     *
+     *  @param  out The output stream.
+     *  @param  format One of "tsv", "binary" or "compressed".
+     *  @param  level The compression level for "compressed" format.
+     *  @param  offset The size of the output to be continued, if any (see `Writer`).
+     */
+    AnyWriter( std::ostream& out, const std::string& format,
+        int level=Z_DEFAULT_COMPRESSION, std::uint64_t offset=0 )
+    {
+      if ( format == "tsv" ) this->tsv.reset( new Writer< TsvFormat >( out, offset ) );
+      else if ( format == "binary" ) {
+        this->bin.reset( new Writer< BinaryFormat >( out, offset ) );
+      }
+      else if ( format == "compressed" ) {
+        this->gz.reset( new Writer< CompressedFormat >( out, level, offset ) );
+      }
+      else throw std::runtime_error( "unknown output format '" + format + "'" );
+    }
+    /* ====================  ACCESSORS     ======================================= */
+      inline std::uint64_t
+    bytes_written( ) const
+    {
+      if ( this->tsv ) return this->tsv->bytes_written();
+      if ( this->bin ) return this->bin->bytes_written();
+      return this->gz->bytes_written();
+    }
+    /* ====================  METHODS       ======================================= */
+    template< typename TNodes >
+        inline void
+      write( std::uint64_t seed, const TNodes& nodes )
+      {
+        if ( this->tsv ) this->tsv->write( seed, nodes );
+        else if ( this->bin ) this->bin->write( seed, nodes );
+        else this->gz->write( seed, nodes );
+      }
+
+      inline void
+    flush( )
+    {
+      if ( this->tsv ) this->tsv->flush();
+      else if ( this->bin ) this->bin->flush();
+      else this->gz->flush();
+    }
+
+    /**
+     *  @brief  Flush the buffered records and the output stream (see `Writer::close`).
+     *
+     *  @return false if the output stream failed.
+     */
+      inline bool
+    close( )
+    {
+      if ( this->tsv ) return this->tsv->close();
+      if ( this->bin ) return this->bin->close();
+      return this->gz->close();
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    std::unique_ptr< Writer< TsvFormat > > tsv;
+    std::unique_ptr< Writer< BinaryFormat > > bin;
+    std::unique_ptr< Writer< CompressedFormat > > gz;
+};  /* -----  end of class AnyWriter  ----- */
+
+/**
+ *  @brief  Reader of a format detected from the input.
+ *
+ *  Binary and compressed inputs are recognised by their magic; anything else is
+ *  read as tab-separated text. The input stream must be seekable.
+ */
+class AnyReader
+{
+  public:
+    /* ====================  LIFECYCLE     ======================================= */
+    AnyReader( std::istream& in )
+    {
+      char magic[ 8 ] = { 0 };
+      in.read( magic, 8 );
+      if ( in.gcount() == 8
+          && std::memcmp( magic, Writer< BinaryFormat >::MAGIC, 8 ) == 0 ) {
+        this->bin.reset( new Reader< BinaryFormat >( in ) );
+        this->fmt = "binary";
+      }
+      else if ( in.gcount() == 8
+          && std::memcmp( magic, Writer< CompressedFormat >::MAGIC, 8 ) == 0 ) {
+        this->gz.reset( new Reader< CompressedFormat >( in ) );
+        this->fmt = "compressed";
+      }
+      else {
+        in.clear();
+        in.seekg( 0 );
+        this->tsv.reset( new Reader< TsvFormat >( in ) );
+        this->fmt = "tsv";
+      }
+    }
+    /* ====================  ACCESSORS     ======================================= */
+    /**
+     *  @brief  Name of the detected format as accepted by `AnyWriter`.
+     */
+      inline const std::string&
+    format( ) const
+    {
+      return this->fmt;
+    }
+    /* ====================  METHODS       ======================================= */
+      inline bool
+    next( std::uint64_t& seed, std::uint64_t& node )
+    {
+      if ( this->tsv ) return this->tsv->next( seed, node );
+      if ( this->bin ) return this->bin->next( seed, node );
+      return this->gz->next( seed, node );
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    std::unique_ptr< Reader< TsvFormat > > tsv;
+    std::unique_ptr< Reader< BinaryFormat > > bin;
+    std::unique_ptr< Reader< CompressedFormat > > gz;
+    std::string fmt;
+};  /* -----  end of class AnyReader  ----- */
+
+#endif  // OUTPUT_H__
@@ -0,0 +1,282 @@
+/**
+ *    @file  pipeline.h
+ *   @brief  Seeding and batch locate pipeline.
+ *
+ *  Extracts seeds by a strategy given by name, finds them in one or more indexes
+ *  and writes their occurrences in the order of the seeds.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  14:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef PIPELINE_H__
+#define PIPELINE_H__
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <omp.h>
+
+#include "locator.h"
+#include "seed.h"
+#include "kmer.h"
+#include "output.h"
+
+
+/**
+ *  @brief  Parameters of a seeding strategy.
+ *
+ *  Only the parameters of the selected strategy are used.
+ */
+struct SeedingParams {
+  std::string strategy = "step";
+  unsigned int seed_len = 20;
+  unsigned int distance = 20;       /* step size; extension step if "adaptive" */
+  unsigned int window = 10;         /* k-mers per window of "minimizer" */
+  unsigned int smer_len = 8;        /* s-mer length of "*-syncmer" */
+  unsigned int max_seed_len = 40;   /* maximum seed length of "adaptive" */
+  unsigned int target_count = 64;   /* maximum paths of an "adaptive" seed */
+};
+
+/**
+ *  @brief  Extract seeds from the sequences by the named seeding strategy.
+ *
+ *  @param  seeds The resulting seeds.
+ *  @param  sequences The input sequences.
+ *  @param  params The strategy, one of "step", "greedy-overlapping", "non-overlapping",
+ *                 "greedy-non-overlapping", "minimizer", "open-syncmer",
+ *                 "closed-syncmer" or "adaptive", and its parameters.
+ *  @param  locators The indexes by which the seeds of the adaptive strategy are
+ *                   extended; they are extended until they are specific in every index.
+ *  @return the length of all seeds, or zero if their lengths vary.
+ */
+template< typename TText >
+    inline unsigned int
+  make_seeds( std::vector< std::string >& seeds, const std::vector< TText >& sequences,
+      const SeedingParams& params, const std::vector< Locator >& locators )
+  {
+    const std::string& strategy = params.strategy;
+    unsigned int k = params.seed_len;
+    if ( strategy == "step" ) seeding( seeds, sequences, k, params.distance );
+    else if ( strategy == "greedy-overlapping" ) {
+      seeding( seeds, sequences, k, GreedyOverlapping() );
+    }
+    else if ( strategy == "non-overlapping" ) {
+      seeding( seeds, sequences, k, NonOverlapping() );
+    }
+    else if ( strategy == "greedy-non-overlapping" ) {
+      seeding( seeds, sequences, k, GreedyNonOverlapping() );
+    }
+    else if ( strategy == "minimizer" ) {
+      seeding( seeds, sequences, k, Minimizers( params.window ) );
+    }
+    else if ( strategy == "closed-syncmer" ) {
+      seeding( seeds, sequences, k, Syncmers( params.smer_len, true ) );
+    }
+    else if ( strategy == "open-syncmer" ) {
+      /* The minimal s-mer in the middle of the k-mer spaces open syncmers best. */
+      seeding( seeds, sequences, k,
+          Syncmers( params.smer_len, false, ( k - params.smer_len ) / 2 ) );
+    }
+    else if ( strategy == "adaptive" ) {
+      seeding( seeds, sequences, k, MultiLocator( locators ),
+          Adaptive( params.max_seed_len, params.target_count, params.distance ) );
+      return 0;
+    }
+    else throw std::runtime_error( "unknown seeding strategy '" + strategy + "'" );
+    return k;
+  }  /* -----  end of template function make_seeds  ----- */
+
+
+/**
+ *  @brief  Batch locate pipeline over one or more indexes.
+ *
+ *  `find` searches the patterns in the indexes, as packed k-mers if they are of a
+ *  supported length (see `dispatch_packed`). `locate` then locates the found
+ *  patterns of an index in batches of `BATCH_SIZE` patterns per thread in parallel
+ *  and writes the occurrences of each batch in the order of the patterns. Ranges of
+ *  more than `chunk_size` paths, if set, are skipped in the parallel step and
+ *  located incrementally by a `LocateCursor` while writing, so that writing their
+ *  occurrences starts before the whole range is located.
+ *
+ *  The locators must outlive the pipeline.
+ */
+class Pipeline
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef Locator::size_type size_type;
+    typedef Locator::range_type range_type;
+    typedef Locator::nodes_type nodes_type;
+    typedef std::chrono::steady_clock clock_type;
+    /* ====================  CONSTANTS     ======================================= */
+    /** @brief Number of patterns located per thread before writing their occurrences. */
+    constexpr static std::size_t BATCH_SIZE = 1024;
+    /* ====================  LIFECYCLE     ======================================= */
+    /**
+     *  @param  l The indexes.
+     *  @param  chunk_size Ranges of more paths are located in chunks; zero for none.
+     */
+    explicit Pipeline( const std::vector< Locator >& l, unsigned int chunk_size=0 )
+      : locators( l ), chunk_size( chunk_size ),
+      batch_size( BATCH_SIZE * std::max( omp_get_max_threads(), 1 ) ),
+      ranges( l.size() ), found( l.size() ), nof_found( 0 ), paths( 0 ),
+      output_time( clock_type::duration::zero() )
+    { }
+    /* ====================  ACCESSORS     ======================================= */
+    /**
+     *  @brief  Indices of the patterns found in the j-th index in increasing order.
+     */
+      inline const std::vector< std::size_t >&
+    get_found( std::size_t j ) const
+    {
+      return this->found[ j ];
+    }
+
+    /**
+     *  @brief  Number of patterns found in all indexes.
+     */
+      inline std::size_t
+    get_nof_found( ) const
+    {
+      return this->nof_found;
+    }
+
+    /**
+     *  @brief  Number of paths matching the patterns in all indexes.
+     */
+      inline size_type
+    get_paths( ) const
+    {
+      return this->paths;
+    }
+
+    /**
+     *  @brief  Time spent by `locate` in writing the occurrences and in its callback.
+     */
+      inline clock_type::duration
+    get_output_time( ) const
+    {
+      return this->output_time;
+    }
+    /* ====================  METHODS       ======================================= */
+    /**
+     *  @brief  Find the patterns in the indexes.
+     *
+     *  @param  patterns The patterns.
+     *  @param  k The length of all patterns, which then hold only A, C, G and T (as
+     *            returned by `make_seeds`), or zero if their lengths vary.
+     *  @param  first The first index to search; earlier ones are skipped.
+     *  @return the number of paths matching the patterns.
+     */
+      inline size_type
+    find( const std::vector< std::string >& patterns, unsigned int k=0,
+        std::size_t first=0 )
+    {
+      std::vector< std::uint64_t > kmers;
+      bool packed = k != 0 && dispatch_packed( k, [&]( auto kk ) {
+          pack< decltype( kk )::value >( kmers, patterns );
+          } );
+      size_type total = 0;
+      for ( std::size_t j = first; j < this->locators.size(); ++j ) {
+        if ( !packed ) total += this->locators[ j ].find( patterns, this->ranges[ j ] );
+        else dispatch_packed( k, [&]( auto kk ) {
+            total += this->locators[ j ].find< decltype( kk )::value >( kmers,
+                this->ranges[ j ] );
+            } );
+        auto& found = this->found[ j ];
+        found.clear();
+        for ( std::size_t i = 0; i < this->ranges[ j ].size(); ++i ) {
+          if ( !gcsa::Range::empty( this->ranges[ j ][ i ] ) ) found.push_back( i );
+        }
+        this->nof_found += found.size();
+      }
+      this->paths += total;
+      return total;
+    }
+
+    /**
+     *  @brief  Locate the found patterns of an index and write their occurrences.
+     *
+     *  @param  j The index.
+     *  @param  writer The output to which the occurrences of pattern `i` are written
+     *                 as record `i`, in increasing order of `i`.
+     *  @param  done The number of found patterns to skip, e.g. when resuming.
+     *  @param  callback Called as `callback( done, occurrences )` after each batch is
+     *                   written, with the number of found patterns done so far and
+     *                   the occurrences of the batch.
+     *  @return the number of occurrences written.
+     */
+    template< typename TCallback >
+        inline size_type
+      locate( std::size_t j, AnyWriter& writer, std::size_t done, TCallback&& callback )
+      {
+        const auto& locator = this->locators[ j ];
+        const auto& found = this->found[ j ];
+        std::vector< range_type > batch_ranges;
+        std::vector< nodes_type > batch;
+        nodes_type chunk;
+        size_type occs = 0;
+        std::size_t step = this->batch_size;
+        for ( std::size_t first = done; first < found.size(); first += step ) {
+          std::size_t last = std::min( first + step, found.size() );
+          batch_ranges.clear();
+          for ( std::size_t i = first; i < last; ++i ) {
+            const auto& range = this->ranges[ j ][ found[ i ] ];
+            batch_ranges.push_back( this->chunked( range ) ? range_type( 1, 0 ) : range );
+          }
+          size_type batch_occs = locator.locate( batch_ranges, batch );
+          auto start = clock_type::now();
+          clock_type::duration chunk_time = clock_type::duration::zero();
+          for ( std::size_t i = first; i < last; ++i ) {
+            const auto& range = this->ranges[ j ][ found[ i ] ];
+            if ( !this->chunked( range ) ) {
+              writer.write( found[ i ], batch[ i - first ] );
+              continue;
+            }
+            LocateCursor cursor( locator, range, this->chunk_size );
+            while ( true ) {
+              auto chunk_start = clock_type::now();
+              bool more = cursor.next( chunk );
+              chunk_time += clock_type::now() - chunk_start;
+              if ( !more ) break;
+              batch_occs += chunk.size();
+              writer.write( found[ i ], chunk );
+            }
+          }
+          occs += batch_occs;
+          callback( last, batch_occs );
+          this->output_time += clock_type::now() - start - chunk_time;
+        }
+        return occs;
+      }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    const std::vector< Locator >& locators;
+    unsigned int chunk_size;
+    std::size_t batch_size;
+    std::vector< std::vector< range_type > > ranges;
+    std::vector< std::vector< std::size_t > > found;
+    std::size_t nof_found;
+    size_type paths;
+    clock_type::duration output_time;
+    /* ====================  METHODS       ======================================= */
+      inline bool
+    chunked( range_type range ) const
+    {
+      return this->chunk_size != 0 && gcsa::Range::length( range ) > this->chunk_size;
+    }
+};  /* -----  end of class Pipeline  ----- */
+
+#endif  // PIPELINE_H__
@@ -18,7 +18,13 @@
 #ifndef  SEED_H__
 #define  SEED_H__
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 
 /* Tag template class. */
@@ -29,11 +35,194 @@ template< typename TSpec >
 struct GreedyOverlapStrategy;
 struct NonOverlapStrategy;
 struct GreedyNonOverlapStrategy;
+struct MinimizerStrategy;
+struct SyncmerStrategy;
+struct AdaptiveStrategy;
+
+/**
+ *  @brief  Tag for (w,k)-minimizer seeding.
+ *
+ *  @param  w The number of consecutive k-mers in a window.
+ */
+template< >
+  struct Tag< MinimizerStrategy > {
+    unsigned int w;
+    explicit Tag( unsigned int window=10 ) : w( window ) { }
+  };
+
+/**
+ *  @brief  Tag for syncmer seeding.
+ *
+ *  @param  s The length of the s-mers.
+ *  @param  closed Whether closed syncmers (minimal s-mer at the first or the last
+ *                 position of the k-mer) or open syncmers (at position `t`) are
+ *                 selected.
+ *  @param  t The position of the minimal s-mer in open syncmers.
+ */
+template< >
+  struct Tag< SyncmerStrategy > {
+    unsigned int s;
+    bool closed;
+    unsigned int t;
+    explicit Tag( unsigned int smer_len=8, bool closed_syncmers=true,
+        unsigned int offset=0 )
+      : s( smer_len ), closed( closed_syncmers ), t( offset ) { }
+  };
+
+/**
+ *  @brief  Tag for adaptive-length seeding.
+ *
+ *  @param  max_len The maximum length of the seeds.
+ *  @param  target The number of occurrences below which a seed is specific enough.
+ *  @param  step The distance between the ends of consecutive seeds.
+ */
+template< >
+  struct Tag< AdaptiveStrategy > {
+    unsigned int max_len;
+    std::uint64_t target;
+    unsigned int step;
+    explicit Tag( unsigned int max_seed_len=32, std::uint64_t target_count=64,
+        unsigned int distance=1 )
+      : max_len( max_seed_len ), target( target_count ), step( distance ) { }
+  };
 
 /* Seeding strategy tags */
 typedef Tag< GreedyOverlapStrategy > GreedyOverlapping;
 typedef Tag< NonOverlapStrategy > NonOverlapping;
 typedef Tag< GreedyNonOverlapStrategy > GreedyNonOverlapping;
+typedef Tag< MinimizerStrategy > Minimizers;
+typedef Tag< SyncmerStrategy > Syncmers;
+typedef Tag< AdaptiveStrategy > Adaptive;
+
+namespace seed_hash {
+  /**
+   *  @brief  2-bit code of a nucleotide; 4 for any other character.
+   */
+    inline std::uint8_t
+  encode( char c )
+  {
+    switch ( c ) {
+      case 'A': case 'a': return 0;
+      case 'C': case 'c': return 1;
+      case 'G': case 'g': return 2;
+      case 'T': case 't': return 3;
+      default: return 4;
+    }
+  }
+
+  /**
+   *  @brief  Invertible 64-bit mixing function (finalizer of MurmurHash3).
+   */
+    inline std::uint64_t
+  mix( std::uint64_t key )
+  {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  /**
+   *  @brief  Rolling hash of the k-mers of a text.
+   *
+   *  The k-mers are kept as polynomials of their 2-bit codes modulo 2^64 and hashed
+   *  by `mix`. For k <= 32 the base is 4, so that the value is the 2-bit packed
+   *  k-mer itself; for longer k-mers it is an odd constant, so that all characters
+   *  contribute. k-mers containing characters other than A, C, G and T are reported
+   *  invalid.
+   */
+  class KmerRoller {
+    public:
+      /* ====================  LIFECYCLE     ======================================= */
+      explicit KmerRoller( unsigned int len )
+        : k( len ), base( len <= 32 ? 4 : 0x9e3779b97f4a7c15ULL ), value( 0 ),
+        valid( 0 ), top( 1 )
+      {
+        for ( unsigned int i = 1; i < len; ++i ) this->top *= this->base;
+      }
+      /* ====================  METHODS       ======================================= */
+      /**
+       *  @brief  Append a character and drop the first character of the k-mer.
+       *
+       *  @param  in The appended character.
+       *  @param  out The dropped character; ignored for the first k characters.
+       *  @return true if the current k-mer is valid.
+       */
+        inline bool
+      roll( char in, char out )
+      {
+        std::uint8_t code = encode( in );
+        if ( this->valid >= this->k ) {
+          this->value -= this->top * encode( out );
+        }
+        if ( code == 4 ) {
+          this->value = 0;
+          this->valid = 0;
+          return false;
+        }
+        this->value = this->value * this->base + code;
+        ++this->valid;
+        return this->valid >= this->k;
+      }
+
+      /**
+       *  @brief  Hash of the current k-mer.
+       */
+        inline std::uint64_t
+      hash( ) const
+      {
+        return mix( this->value );
+      }
+    private:
+      /* ====================  DATA MEMBERS  ======================================= */
+      unsigned int k;
+      std::uint64_t base;
+      std::uint64_t value;
+      unsigned int valid;         /**< @brief Number of valid characters at the end. */
+      std::uint64_t top;          /**< @brief base^(k-1) modulo 2^64. */
+  };  /* -----  end of class KmerRoller  ----- */
+}  /* -----  end of namespace seed_hash  ----- */
+
+/**
+ *  @brief  Call a function on each stretch of a text long enough to hold a seed.
+ *
+ *  @param  text The text.
+ *  @param  k The length of the seeds.
+ *  @param  callback Called as `callback( begin, end )` for each maximal stretch
+ *                   [begin, end) of A, C, G and T of length at least `k`.
+ *
+ *  The text is scanned once; stretches are split at any other character, such as N,
+ *  so that no seed contains one. Texts shorter than `k` have no stretches.
+ */
+template< typename TText, typename TCallback >
+    inline void
+  for_each_stretch( const TText& text, unsigned int k, TCallback callback )
+  {
+    if ( k == 0 || text.length() < k ) return;
+    std::size_t begin = 0;
+    for ( std::size_t i = 0; i < text.length(); ++i ) {
+      if ( seed_hash::encode( text[ i ] ) != 4 ) continue;
+      if ( i - begin >= k ) callback( begin, i );
+      begin = i + 1;
+    }
+    if ( text.length() - begin >= k ) callback( begin, text.length() );
+  }  /* -----  end of template function for_each_stretch  ----- */
+
+/**
+ *  @brief  Count the texts of a string set which are shorter than the seed length.
+ */
+template< typename TText >
+    inline std::size_t
+  count_short( const std::vector< TText >& string_set, unsigned int k )
+  {
+    std::size_t count = 0;
+    for ( const auto& text : string_set ) {
+      if ( text.length() < k ) ++count;
+    }
+    return count;
+  }  /* -----  end of template function count_short  ----- */
 
 /**
  *  @brief  Add any k-mers from the given string set with `step` distance to seed set.
@@ -45,7 +234,9 @@ typedef Tag< GreedyNonOverlapStrategy > GreedyNonOverlapping;
  *
  *  For each string in string set, it add all substring of length `k` starting from 0
  *  to end of string with `step` distance with each other. If `step` is equal to `k`,
- *  it gets non-overlapping substrings of length k.
+ *  it gets non-overlapping substrings of length k. Strings are split at characters
+ *  other than A, C, G and T, and each stretch is seeded from its start; strings and
+ *  stretches shorter than `k` give no seeds.
  */
 template< typename TText >
     inline void
@@ -55,9 +246,12 @@ template< typename TText >
       unsigned int step )
   {
     for ( unsigned int idx = 0; idx < string_set.size(); ++idx ) {
-      for ( unsigned int i = 0; i < string_set[idx].length() - k + 1; i += step ) {
-        seeds.push_back( string_set[idx].substr( i, k ) );
-      }
+      const TText& text = string_set[ idx ];
+      for_each_stretch( text, k, [&]( std::size_t begin, std::size_t end ) {
+          for ( std::size_t i = begin; i + k <= end; i += step ) {
+            seeds.push_back( text.substr( i, k ) );
+          }
+        } );
     }
   }  /* -----  end of template function seeding  ----- */
 
@@ -115,6 +309,8 @@ template< typename TText >
  *
  *  NOTE: In case that the length of sequence is not dividable by k the last seed
  *        may overlap its previous (greedy).
+ *
+ *  As with step seeding, each stretch of A, C, G and T is partitioned separately.
  */
 template< typename TText >
     inline void
@@ -126,11 +322,175 @@ template< typename TText >
     seeds.clear();
 
     for ( unsigned int idx = 0; idx < string_set.size(); ++idx ) {
-      for ( unsigned int i = 0; i < string_set[idx].length() - k; i += k ) {
-        seeds.push_back( string_set[idx].substr( i, k ) );
+      const TText& text = string_set[ idx ];
+      for_each_stretch( text, k, [&]( std::size_t begin, std::size_t end ) {
+          for ( std::size_t i = begin; i + k < end; i += k ) {
+            seeds.push_back( text.substr( i, k ) );
+          }
+          seeds.push_back( text.substr( end - k, k ) );
+        } );
+    }
+  }  /* -----  end of function seeding  ----- */
+
+/**
+ *  @brief  Seeding by (w,k)-minimizers.
+ *
+ *  @param  seeds The resulting set of strings containing seeds.
+ *  @param  string_set The string set from which seeds are extracted.
+ *  @param  k The length of the seeds.
+ *  @param  tag Tag for minimizer seeding strategy holding the window size `w`.
+ *
+ *  Extract the k-mer with the smallest hash (the leftmost one on ties) in each
+ *  window of `w` consecutive k-mers, reporting each selected k-mer once. Since the
+ *  selection only depends on the window, overlapping reads share the minimizers of
+ *  their shared windows, while about 2/(w+1) of the k-mers are selected. k-mers
+ *  containing characters other than A, C, G and T are not selected; a stretch of
+ *  valid k-mers shorter than a window contributes its minimum. The sliding minimum
+ *  is maintained by a monotone deque in linear time.
+ */
+template< typename TText >
+    inline void
+  seeding( std::vector< TText >& seeds,
+      const std::vector< TText >& string_set,
+      unsigned int k,
+      Minimizers tag )
+  {
+    seeds.clear();
+    if ( k == 0 ) return;
+    unsigned int w = tag.w == 0 ? 1 : tag.w;
+    /* Candidates as (hash, start position) with increasing hashes. */
+    std::deque< std::pair< std::uint64_t, std::size_t > > window;
+
+    for ( unsigned int idx = 0; idx < string_set.size(); ++idx ) {
+      const TText& text = string_set[ idx ];
+      std::size_t length = text.length();
+      seed_hash::KmerRoller roller( k );
+      std::size_t last = static_cast< std::size_t >( -1 );  /* last selected start */
+      std::size_t run = 0;                                  /* valid k-mers in a row */
+      window.clear();
+      for ( std::size_t i = 0; i <= length; ++i ) {
+        bool valid = i < length && roller.roll( text[ i ], i >= k ? text[ i - k ] : 'A' );
+        if ( !valid ) {
+          /* End of a stretch of valid k-mers; select its minimum if it was too
+           * short to fill a window. */
+          if ( run != 0 && run < w && window.front().second != last ) {
+            last = window.front().second;
+            seeds.push_back( text.substr( last, k ) );
+          }
+          run = 0;
+          window.clear();
+          continue;
+        }
+        std::size_t pos = i + 1 - k;
+        std::uint64_t hash = roller.hash();
+        while ( !window.empty() && window.back().first > hash ) window.pop_back();
+        window.emplace_back( hash, pos );
+        if ( window.front().second + w <= pos ) window.pop_front();
+        if ( ++run >= w && window.front().second != last ) {
+          last = window.front().second;
+          seeds.push_back( text.substr( last, k ) );
+        }
       }
-      unsigned int last = string_set[idx].length() - k;
-      seeds.push_back( string_set[idx].substr( last, k ) );
+    }
+  }  /* -----  end of function seeding  ----- */
+
+/**
+ *  @brief  Seeding by open or closed syncmers.
+ *
+ *  @param  seeds The resulting set of strings containing seeds.
+ *  @param  string_set The string set from which seeds are extracted.
+ *  @param  k The length of the seeds.
+ *  @param  tag Tag for syncmer seeding strategy holding s, the kind and t.
+ *
+ *  Extract the k-mers whose s-mer with the smallest hash (the leftmost one on ties)
+ *  is at their first or last position (closed syncmers) or at position `t` (open
+ *  syncmers). Unlike minimizers, whether a k-mer is selected depends only on the
+ *  k-mer itself, so a mutation only affects the selection of the k-mers covering it
+ *  and the selected k-mers of a graph can be precomputed. k-mers containing
+ *  characters other than A, C, G and T are not selected. If `s` is zero or larger
+ *  than `k`, it is taken as `k`.
+ */
+template< typename TText >
+    inline void
+  seeding( std::vector< TText >& seeds,
+      const std::vector< TText >& string_set,
+      unsigned int k,
+      Syncmers tag )
+  {
+    seeds.clear();
+    if ( k == 0 ) return;
+    unsigned int s = ( tag.s == 0 || tag.s > k ) ? k : tag.s;
+    unsigned int span = k - s + 1;    /* number of s-mers in a k-mer */
+    /* Candidate s-mers as (hash, start position) with increasing hashes. */
+    std::deque< std::pair< std::uint64_t, std::size_t > > window;
+
+    for ( unsigned int idx = 0; idx < string_set.size(); ++idx ) {
+      const TText& text = string_set[ idx ];
+      seed_hash::KmerRoller roller( s );
+      std::size_t run = 0;                                  /* valid s-mers in a row */
+      window.clear();
+      for ( std::size_t i = 0; i < text.length(); ++i ) {
+        if ( !roller.roll( text[ i ], i >= s ? text[ i - s ] : 'A' ) ) {
+          run = 0;
+          window.clear();
+          continue;
+        }
+        std::size_t pos = i + 1 - s;
+        std::uint64_t hash = roller.hash();
+        while ( !window.empty() && window.back().first > hash ) window.pop_back();
+        window.emplace_back( hash, pos );
+        if ( window.front().second + span <= pos ) window.pop_front();
+        if ( ++run < span ) continue;
+        std::size_t start = pos + 1 - span;
+        std::size_t offset = window.front().second - start;
+        if ( tag.closed ? ( offset == 0 || offset == span - 1 ) : offset == tag.t ) {
+          seeds.push_back( text.substr( start, k ) );
+        }
+      }
+    }
+  }  /* -----  end of function seeding  ----- */
+
+/**
+ *  @brief  Seeding by seeds extended until they are specific enough.
+ *
+ *  @param  seeds The resulting set of strings containing seeds.
+ *  @param  string_set The string set from which seeds are extracted.
+ *  @param  k The minimum length of the seeds.
+ *  @param  locator The index by which the specificity of the seeds is measured; it
+ *                  should provide `find_adaptive` as `Locator` and `MultiLocator` do.
+ *  @param  tag Tag for adaptive seeding strategy holding the maximum length, the
+ *              target number of occurrences and the step.
+ *
+ *  Seeds end at the positions `k`, `k + step`, ... of each stretch of A, C, G and T.
+ *  Each is extended backwards past `k` bases while it has more than `target`
+ *  occurrences, up to `max_len` bases or the start of the stretch. A seed stops
+ *  early where its next extension does not occur. Ends whose `k`-mer does not occur
+ *  give no seed. So repeats get longer seeds whose locate cost stays bounded, while
+ *  unique regions keep seeds of length `k`, as with step seeding.
+ */
+template< typename TText, typename TLocator >
+    inline void
+  seeding( std::vector< TText >& seeds,
+      const std::vector< TText >& string_set,
+      unsigned int k,
+      TLocator&& locator,
+      Adaptive tag )
+  {
+    seeds.clear();
+    if ( tag.step == 0 ) return;
+    std::size_t max_len = std::max( tag.max_len, k );
+    for ( unsigned int idx = 0; idx < string_set.size(); ++idx ) {
+      const TText& text = string_set[ idx ];
+      for_each_stretch( text, k, [&]( std::size_t begin, std::size_t end ) {
+          for ( std::size_t last = begin + k; last <= end; last += tag.step ) {
+            std::size_t first = last - std::min( max_len, last - begin );
+            typename std::decay< TLocator >::type::size_type len;
+            locator.find_adaptive( text.begin() + first, text.begin() + last, k,
+                tag.target, len );
+            if ( len < k ) continue;
+            seeds.push_back( text.substr( last - len, len ) );
+          }
+        } );
     }
   }  /* -----  end of function seeding  ----- */
 
@@ -0,0 +1,144 @@
+/**
+ *    @file  shard.h
+ *   @brief  Input sharding.
+ *
+ *  Splits the sequence file into byte ranges aligned to line boundaries and records
+ *  the shard of an output so that shard outputs can be merged.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sun Oct 18, 2026  12:00
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef SHARD_H__
+#define SHARD_H__
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+/**
+ *  @brief  Shard of an input and of the corresponding output.
+ *
+ *  Shard `index` out of `count` consists of the lines starting in the byte range
+ *  [size * index / count, size * (index + 1) / count) of the input, so that each line
+ *  belongs to exactly one shard. `patterns` is the number of patterns extracted from
+ *  the shard, by which the seed identifiers of the following shards are shifted when
+ *  merging.
+ */
+struct Shard {
+  unsigned int index = 0;
+  unsigned int count = 1;
+  std::uint64_t patterns = 0;
+
+  /** @brief Suffix of the file holding the shard of an output. */
+  constexpr static const char* SUFFIX = ".shard";
+
+  /**
+   *  @brief  Parse a shard given as "INDEX/COUNT" (zero-based index).
+   */
+    static inline Shard
+  parse( const std::string& str )
+  {
+    Shard shard;
+    std::size_t slash = str.find( '/' );
+    std::size_t ilen = 0;
+    std::size_t clen = 0;
+    try {
+      shard.index = std::stoul( str.substr( 0, slash ), &ilen );
+      if ( slash != std::string::npos ) {
+        shard.count = std::stoul( str.substr( slash + 1 ), &clen );
+      }
+    }
+    catch ( const std::logic_error& ) {
+      slash = std::string::npos;
+    }
+    if ( slash == std::string::npos || ilen != slash || clen != str.size() - slash - 1
+        || shard.count == 0 || shard.index >= shard.count ) {
+      throw std::runtime_error( "invalid shard '" + str + "'; expected INDEX/COUNT "
+          "with 0 <= INDEX < COUNT" );
+    }
+    return shard;
+  }
+
+  /**
+   *  @brief  Read the shard of an output from its shard file.
+   */
+    static inline Shard
+  load( const std::string& output_filename )
+  {
+    std::string filename = output_filename + SUFFIX;
+    std::ifstream ifs( filename, std::ifstream::in );
+    if ( !ifs ) throw std::runtime_error( "could not open file '" + filename + "'" );
+    std::string key;
+    std::string value;
+    Shard shard;
+    if ( !( ifs >> key >> value ) || key != "shard" ) {
+      throw std::runtime_error( "malformed shard file '" + filename + "'" );
+    }
+    shard = Shard::parse( value );
+    if ( !( ifs >> key >> shard.patterns ) || key != "patterns" ) {
+      throw std::runtime_error( "malformed shard file '" + filename + "'" );
+    }
+    return shard;
+  }
+
+  /**
+   *  @brief  Write the shard file of an output.
+   */
+    inline void
+  save( const std::string& output_filename ) const
+  {
+    std::string filename = output_filename + SUFFIX;
+    std::ofstream ofs( filename, std::ofstream::out );
+    if ( !ofs ) throw std::runtime_error( "could not open file '" + filename + "'" );
+    ofs << "shard " << this->index << "/" << this->count << std::endl
+        << "patterns " << this->patterns << std::endl;
+  }
+
+  /**
+   *  @brief  Read the lines of the shard from a seekable input.
+   *
+   *  Only the shard's byte range (and the rest of the line at its end) is read.
+   *
+   *  @param  lines The lines of the shard are appended to it.
+   *  @param  in The input stream.
+   */
+    inline void
+  read_lines( std::vector< std::string >& lines, std::istream& in ) const
+  {
+    in.seekg( 0, std::istream::end );
+    std::uint64_t size = in.tellg();
+    std::uint64_t first = size * this->index / this->count;
+    std::uint64_t last = size * ( this->index + 1 ) / this->count;
+    std::uint64_t pos = first;
+    std::string line;
+    if ( first != 0 ) {
+      /* Skip the line started in the previous shard, if any. */
+      in.seekg( first - 1 );
+      if ( in.get() != '\n' ) {
+        std::getline( in, line );
+        pos += line.size() + 1;
+      }
+    }
+    else {
+      in.seekg( 0 );
+    }
+    while ( pos < last && std::getline( in, line ) ) {
+      pos += line.size() + 1;
+      lines.push_back( line );
+    }
+  }
+};
+
+#endif  // SHARD_H__
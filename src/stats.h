@@ -0,0 +1,150 @@
+/**
+ *    @file  stats.h
+ *   @brief  Run statistics.
+ *
+ *  Collects phase timings and counters of a run and serializes them as JSON.
+ *
+ *  @author  Ali Ghaffaari (\@cartoonist), <ali.ghaffaari@mpi-inf.mpg.de>
+ *
+ *  @internal
+ *       Created:  Sat Oct 17, 2026  11:30
+ *  Organization:  Max-Planck-Institut fuer Informatik
+ *     Copyright:  Copyright (c) 2017, Ali Ghaffaari
+ *
+ *  This source code is released under the terms of the MIT License.
+ *  See LICENSE file for more information.
+ */
+
+#ifndef STATS_H__
+#define STATS_H__
+
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <utility>
+
+
+/**
+ *  @brief  Statistics of a single run.
+ *
+ *  Keeps three ordered sections: the run context (options), the phase durations in
+ *  microseconds, and the counters. The JSON representation puts each entry on its
+ *  own line so that it can be processed by line-oriented tools as well.
+ */
+class Stats
+{
+  public:
+    /* ====================  MEMBER TYPES  ======================================= */
+    typedef std::vector< std::pair< std::string, std::string > > context_type;
+    typedef std::vector< std::pair< std::string, long long int > > values_type;
+    /* ====================  METHODS       ======================================= */
+      inline void
+    set_context( const std::string& key, const std::string& value )
+    {
+      Stats::set( this->context, key, "\"" + Stats::escape( value ) + "\"" );
+    }
+
+      inline void
+    set_context( const std::string& key, long long int value )
+    {
+      Stats::set( this->context, key, std::to_string( value ) );
+    }
+
+      inline void
+    set_phase( const std::string& name, long long int usecs )
+    {
+      Stats::set( this->phases, name, usecs );
+    }
+
+      inline void
+    set_counter( const std::string& name, long long int value )
+    {
+      Stats::set( this->counters, name, value );
+    }
+
+    /**
+     *  @brief  Peak resident set size of the process in kilobytes.
+     */
+      static inline long long int
+    max_rss( )
+    {
+      struct rusage usage;
+      if ( getrusage( RUSAGE_SELF, &usage ) != 0 ) return 0;
+      return usage.ru_maxrss;
+    }
+
+    /**
+     *  @brief  Current resident set size of the process in kilobytes.
+     *
+     *  Read from `/proc/self/statm`; zero if it is not available.
+     */
+      static inline long long int
+    current_rss( )
+    {
+      std::ifstream statm( "/proc/self/statm", std::ifstream::in );
+      long long int size = 0;
+      long long int resident = 0;
+      if ( !( statm >> size >> resident ) ) return 0;
+      return resident * ( sysconf( _SC_PAGESIZE ) / 1024 );
+    }
+
+      inline void
+    to_json( std::ostream& out ) const
+    {
+      out << "{" << std::endl;
+      Stats::write_section( out, "context", this->context );
+      out << "," << std::endl;
+      Stats::write_section( out, "phases", this->phases );
+      out << "," << std::endl;
+      Stats::write_section( out, "counters", this->counters );
+      out << std::endl << "}" << std::endl;
+    }
+  private:
+    /* ====================  DATA MEMBERS  ======================================= */
+    context_type context;
+    values_type phases;
+    values_type counters;
+    /* ====================  METHODS       ======================================= */
+    template< typename TSection, typename TValue >
+        static inline void
+      set( TSection& section, const std::string& key, const TValue& value )
+      {
+        for ( auto& entry : section ) {
+          if ( entry.first == key ) {
+            entry.second = value;
+            return;
+          }
+        }
+        section.emplace_back( key, value );
+      }
+
+      static inline std::string
+    escape( const std::string& str )
+    {
+      std::string retval;
+      for ( char c : str ) {
+        if ( c == '"' || c == '\\' ) retval += '\\';
+        retval += c;
+      }
+      return retval;
+    }
+
+    template< typename TSection >
+        static inline void
+      write_section( std::ostream& out, const std::string& name,
+          const TSection& section )
+      {
+        out << "  \"" << name << "\": {";
+        for ( std::size_t i = 0; i < section.size(); ++i ) {
+          out << ( i == 0 ? "" : "," ) << std::endl
+              << "    \"" << section[i].first << "\": " << section[i].second;
+        }
+        out << std::endl << "  }";
+      }
+};  /* -----  end of class Stats  ----- */
+
+#endif  // STATS_H__